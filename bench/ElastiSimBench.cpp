@@ -0,0 +1,172 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <json.hpp>
+
+#include "ElastiSim.h"
+#include "StubScheduler.h"
+#include "SyntheticScenario.h"
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> split(const std::string& list) {
+	std::vector<std::string> items;
+	std::stringstream stream(list);
+	std::string item;
+	while (getline(stream, item, ',')) {
+		items.push_back(item);
+	}
+	return items;
+}
+
+// runs a single scenario together with the stub scheduler in this process
+static int runScenario(int argc, char* argv[]) {
+	std::ifstream stream(argv[1]);
+	const nlohmann::json configuration = nlohmann::json::parse(stream);
+	StubScheduler scheduler(configuration["zmq_url"]);
+	std::thread schedulerThread([&scheduler] { scheduler(); });
+	ElastiSim::startSimulation(argc, argv);
+	schedulerThread.join();
+	return EXIT_SUCCESS;
+}
+
+// every scenario runs in a child process to isolate the simulator's global state and peak memory usage
+static bool spawnScenario(const char* executable, const fs::path& configuration) {
+	pid_t pid = fork();
+	if (pid == 0) {
+		execl(executable, executable, "--run", configuration.c_str(), "--log=root.thresh:critical",
+			  (char*) nullptr);
+		_exit(EXIT_FAILURE);
+	}
+	int status = 0;
+	waitpid(pid, &status, 0);
+	return WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+}
+
+static void printUsage() {
+	std::cout << "Usage: elastisim-bench [options]\n"
+			  << "  --nodes <list>      platform sizes (default: 64,1024,16384,65536)\n"
+			  << "  --workloads <list>  synthetic workloads out of rigid,malleable,evolving (default: all)\n"
+			  << "  --jobs <n>          number of jobs per scenario (default: 256)\n"
+			  << "  --transport <name>  scheduler transport, ipc or shm (default: ipc)\n"
+			  << "  --output <file>     additionally write the results as CSV\n"
+			  << "  --keep              keep the generated scenarios and simulation outputs\n";
+}
+
+int main(int argc, char* argv[]) {
+
+	if (argc > 2 && std::string(argv[1]) == "--run") {
+		return runScenario(argc - 1, argv + 1);
+	}
+
+	std::vector<std::string> nodeList = {"64", "1024", "16384", "65536"};
+	std::vector<std::string> workloads = {"rigid", "malleable", "evolving"};
+	int numJobs = 256;
+	std::string transport = "ipc";
+	std::string output;
+	bool keep = false;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--nodes" && i + 1 < argc) {
+			nodeList = split(argv[++i]);
+		} else if (argument == "--workloads" && i + 1 < argc) {
+			workloads = split(argv[++i]);
+		} else if (argument == "--jobs" && i + 1 < argc) {
+			numJobs = std::stoi(argv[++i]);
+		} else if (argument == "--transport" && i + 1 < argc) {
+			transport = argv[++i];
+		} else if (argument == "--output" && i + 1 < argc) {
+			output = argv[++i];
+		} else if (argument == "--keep") {
+			keep = true;
+		} else {
+			printUsage();
+			return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	std::ofstream csv;
+	if (!output.empty()) {
+		csv.open(output);
+		csv << "Nodes,Workload,Wall time,Simulated time,Messages,Messages/s,Peak RSS (KiB),Invocations,"
+			<< "Mean scheduling send and wait,Parsing,Model evaluation,Serialization" << std::endl;
+	}
+
+	std::cout << std::left << std::setw(8) << "Nodes" << std::setw(11) << "Workload" << std::right
+			  << std::setw(10) << "Wall [s]" << std::setw(12) << "Messages/s" << std::setw(13) << "Peak RSS [MiB]"
+			  << std::setw(14) << "Send+wait [ms]" << std::setw(12) << "Parse [s]" << std::setw(12) << "Model [s]"
+			  << std::setw(12) << "Serial. [s]" << std::endl;
+
+	fs::path root = fs::temp_directory_path() / ("elastisim-bench-" + std::to_string(getpid()));
+	bool failed = false;
+	for (const auto& nodes: nodeList) {
+		for (const auto& workload: workloads) {
+			fs::path directory = root / (nodes + "-" + workload);
+			fs::path configuration = SyntheticScenario::writeConfiguration(directory, std::stoi(nodes), workload,
+																		   numJobs);
+			if (transport == "shm") {
+				std::ifstream input(configuration);
+				nlohmann::json json = nlohmann::json::parse(input);
+				input.close();
+				json["zmq_url"] = "shm://elastisim-bench-" + std::to_string(getpid()) + "-" + nodes + "-" + workload;
+				std::ofstream(configuration) << json.dump(4) << std::endl;
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			bool success = spawnScenario("/proc/self/exe", configuration);
+			double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (!success || !fs::exists(directory / "profile.json")) {
+				std::cerr << "Scenario " << nodes << "-" << workload << " failed" << std::endl;
+				failed = true;
+				continue;
+			}
+
+			std::ifstream stream(directory / "profile.json");
+			const nlohmann::json profile = nlohmann::json::parse(stream);
+			const nlohmann::json& durations = profile["durations"];
+			const nlohmann::json& counters = profile["counters"];
+			double simulation = durations["simulation"];
+			// events only count the messages received by the scheduler and the simulation engine
+			long long messages = counters["events"];
+			long long invocations = counters["scheduling_invocations"];
+			double messageRate = simulation > 0 ? messages / simulation : 0;
+			// the scheduling duration covers sending the request and waiting for the reply
+			double latency = invocations > 0 ? 1e3 * (double) durations["scheduling"] / invocations : 0;
+			long peakMemory = profile["peak_memory_usage_kb"];
+
+			std::cout << std::left << std::setw(8) << nodes << std::setw(11) << workload << std::right
+					  << std::fixed << std::setprecision(2) << std::setw(10) << wallTime << std::setw(12)
+					  << std::setprecision(0) << messageRate << std::setw(13) << std::setprecision(1)
+					  << peakMemory / 1024.0 << std::setw(14) << std::setprecision(3) << latency << std::setw(12)
+					  << (double) durations["parsing"] << std::setw(12) << (double) durations["model_evaluation"]
+					  << std::setw(12) << (double) durations["serialization"] << std::endl;
+			if (csv.is_open()) {
+				csv << nodes << "," << workload << "," << wallTime << "," << (double) profile["simulated_time"] << ","
+					<< messages << "," << messageRate << "," << peakMemory << "," << invocations << "," << latency
+					<< "," << (double) durations["parsing"] << "," << (double) durations["model_evaluation"] << ","
+					<< (double) durations["serialization"] << std::endl;
+			}
+		}
+	}
+	if (!keep) {
+		fs::remove_all(root);
+	}
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,301 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+#include <simgrid/s4u.hpp>
+#include <json.hpp>
+
+#include "SyntheticScenario.h"
+#include "Configuration.h"
+#include "PlatformManager.h"
+#include "SchedulingInterface.h"
+#include "Utility.h"
+#include "Node.h"
+#include "NodeClass.h"
+#include "Job.h"
+#include "Workload.h"
+#include "Phase.h"
+#include "Task.h"
+
+namespace fs = std::filesystem;
+
+static const int NUM_NODES = 4096;
+static const int JOB_SIZE = 64;
+static const int NUM_JOBS = NUM_NODES / JOB_SIZE;
+
+static std::string filter;
+static double minTime = 0.5;
+
+template<typename T>
+static void doNotOptimize(const T& value) {
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// grows the number of iterations until the measurement covers at least minTime seconds and reports the time per
+// iteration, measure runs the given number of iterations and returns the measured seconds
+template<typename M>
+static void run(const std::string& name, M measure) {
+	if (!filter.empty() && name.find(filter) == std::string::npos) {
+		return;
+	}
+	size_t iterations = 1;
+	double elapsed;
+	while (true) {
+		elapsed = measure(iterations);
+		if (elapsed >= minTime || iterations >= 1000000000) {
+			break;
+		}
+		double factor = elapsed > 0 ? std::clamp(1.4 * minTime / elapsed, 1.4, 10.0) : 10.0;
+		iterations = (size_t) ((double) iterations * factor);
+	}
+	std::cout << std::left << std::setw(48) << name << std::right << std::setw(14) << std::fixed
+			  << std::setprecision(0) << elapsed * 1e9 / (double) iterations << " ns" << std::setw(12) << iterations
+			  << std::endl;
+}
+
+template<typename F>
+static void benchmark(const std::string& name, F function) {
+	run(name, [&function](size_t iterations) {
+		auto start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < iterations; ++i) {
+			function();
+		}
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	});
+}
+
+// as above, but restores the state the function modifies before every iteration without measuring it
+template<typename F, typename R>
+static void benchmark(const std::string& name, F function, R reset) {
+	run(name, [&function, &reset](size_t iterations) {
+		double elapsed = 0;
+		for (size_t i = 0; i < iterations; ++i) {
+			reset();
+			auto start = std::chrono::steady_clock::now();
+			function();
+			elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		}
+		return elapsed;
+	});
+}
+
+static std::string asString(VectorPattern pattern) {
+	switch (pattern) {
+		case ALL_RANKS:
+			return "all_ranks";
+		case ROOT_ONLY:
+			return "root_only";
+		case EVEN_RANKS:
+			return "even_ranks";
+		case ODD_RANKS:
+			return "odd_ranks";
+		case UNIFORM:
+			return "uniform";
+		default:
+			return "vector";
+	}
+}
+
+static std::string asString(MatrixPattern pattern) {
+	switch (pattern) {
+		case ALL_TO_ALL:
+			return "all_to_all";
+		case GATHER:
+			return "gather";
+		case SCATTER:
+			return "scatter";
+		case MASTER_WORKER:
+			return "master_worker";
+		case RING:
+			return "ring";
+		case RING_CLOCKWISE:
+			return "ring_clockwise";
+		case RING_COUNTER_CLOCKWISE:
+			return "ring_counter_clockwise";
+		default:
+			return "matrix";
+	}
+}
+
+static void benchmarkFormulas() {
+	std::map<std::string, std::string> runtimeArguments = {{"batch_size", "256"}};
+	std::map<std::string, std::string> additionalArguments = {{"iteration", "7"}};
+	benchmark("evaluateFormula/constant", [] {
+		doNotOptimize(Utility::evaluateFormula("1e12 * 2 + 3"));
+	});
+	benchmark("evaluateFormula/num_nodes", [] {
+		doNotOptimize(Utility::evaluateFormula("1e12 / num_nodes * num_gpus", 64, 4));
+	});
+	benchmark("evaluateFormula/runtime_arguments", [&runtimeArguments] {
+		doNotOptimize(Utility::evaluateFormula("batch_size * 1e9 / num_nodes", 64, 4, runtimeArguments));
+	});
+	benchmark("evaluateFormula/additional_arguments", [&runtimeArguments, &additionalArguments] {
+		doNotOptimize(Utility::evaluateFormula("batch_size * iteration / num_nodes", 64, 4, runtimeArguments,
+											   additionalArguments));
+	});
+}
+
+static void benchmarkVectorsAndMatrices() {
+	for (VectorPattern pattern: {ALL_RANKS, ROOT_ONLY, EVEN_RANKS, ODD_RANKS, UNIFORM}) {
+		for (int numNodes: {16, 256, 4096}) {
+			benchmark("createVector/" + asString(pattern) + "/" + std::to_string(numNodes), [pattern, numNodes] {
+				doNotOptimize(Utility::createVector(1e9, pattern, numNodes));
+			});
+		}
+		benchmark("createVector/" + asString(pattern) + "/model/256", [pattern] {
+			doNotOptimize(Utility::createVector("1e9 * num_nodes", pattern, 256, 0));
+		});
+	}
+	for (MatrixPattern pattern: {ALL_TO_ALL, GATHER, SCATTER, MASTER_WORKER, RING, RING_CLOCKWISE,
+								 RING_COUNTER_CLOCKWISE}) {
+		for (int numNodes: {16, 256, 1024}) {
+			benchmark("createMatrix/" + asString(pattern) + "/" + std::to_string(numNodes), [pattern, numNodes] {
+				doNotOptimize(Utility::createMatrix(1e9, pattern, numNodes));
+			});
+		}
+		benchmark("createMatrix/" + asString(pattern) + "/model/256", [pattern] {
+			doNotOptimize(Utility::createMatrix("1e9 * num_nodes", pattern, 256, 0));
+		});
+	}
+	// GPU communication is only defined for all-to-all and ring patterns
+	for (MatrixPattern pattern: {ALL_TO_ALL, RING, RING_CLOCKWISE, RING_COUNTER_CLOCKWISE}) {
+		for (int numNodes: {16, 256, 1024}) {
+			benchmark("createMatrices/" + asString(pattern) + "/" + std::to_string(numNodes) + "x4",
+					  [pattern, numNodes] {
+						  doNotOptimize(Utility::createMatrices(1e9, pattern, numNodes, 4));
+					  });
+		}
+	}
+}
+
+static void benchmarkSerialization(const std::vector<Job*>& jobQueue) {
+	const std::vector<Node*>& nodes = PlatformManager::getComputeNodes();
+	std::vector<Node*> assignedNodes(nodes.begin(), nodes.begin() + JOB_SIZE);
+	jobQueue.front()->assignNodes(assignedNodes);
+	benchmark("Job::toJson/" + std::to_string(JOB_SIZE), [&jobQueue] {
+		doNotOptimize(jobQueue.front()->toJson());
+	});
+	jobQueue.front()->assignNodes({});
+	benchmark("Node::toJson", [&nodes] {
+		doNotOptimize(nodes.front()->toJson());
+	});
+	benchmark("Node::toJson/all/" + std::to_string(nodes.size()), [&nodes] {
+		nlohmann::json json = nlohmann::json::array();
+		for (const auto& node: nodes) {
+			json.push_back(node->toJson());
+		}
+		doNotOptimize(json.dump());
+	});
+}
+
+static void benchmarkHandleSchedule(const std::vector<Job*>& jobQueue) {
+	nlohmann::json plainReply = nlohmann::json::array();
+	nlohmann::json rangeReply = nlohmann::json::array();
+	for (const auto& job: jobQueue) {
+		nlohmann::json jsonJob = {{"id", job->getId()}, {"kill_flag", false}, {"modified_runtime_args", false}};
+		int first = job->getId() * JOB_SIZE;
+		jsonJob["assigned_node_ids"] = nlohmann::json::array();
+		for (int i = first; i < first + JOB_SIZE; ++i) {
+			jsonJob["assigned_node_ids"].push_back(i);
+		}
+		plainReply.push_back(jsonJob);
+		jsonJob["assigned_node_ids"] = {{first, first + JOB_SIZE - 1}};
+		rangeReply.push_back(jsonJob);
+	}
+	std::string suffix = "/" + std::to_string(NUM_JOBS) + "x" + std::to_string(JOB_SIZE);
+	// every iteration assigns the nodes to pending jobs without any previous assignment
+	const auto& reset = [&jobQueue] {
+		for (const auto& job: jobQueue) {
+			job->setState(PENDING);
+			job->assignNodes({});
+		}
+		PlatformManager::clearModifiedJobs();
+		PlatformManager::clearModifiedComputeNodes();
+	};
+	benchmark("handleSchedule/plain" + suffix, [&jobQueue, &plainReply] {
+		doNotOptimize(SchedulingInterface::handleSchedule(plainReply, jobQueue));
+	}, reset);
+	benchmark("handleSchedule/ranges" + suffix, [&jobQueue, &rangeReply] {
+		doNotOptimize(SchedulingInterface::handleSchedule(rangeReply, jobQueue));
+	}, reset);
+	reset();
+}
+
+static void printUsage() {
+	std::cout << "Usage: elastisim-microbench [options]\n"
+			  << "  --filter <substring>  only run benchmarks whose name contains the substring\n"
+			  << "  --min-time <seconds>  minimum measured time per benchmark (default: 0.5)\n";
+}
+
+int main(int argc, char* argv[]) {
+
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--filter" && i + 1 < argc) {
+			filter = argv[++i];
+		} else if (argument == "--min-time" && i + 1 < argc) {
+			minTime = std::stod(argv[++i]);
+		} else {
+			printUsage();
+			return argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+	}
+
+	// a loaded platform is required for nodes and jobs, but no actors are ever started
+	fs::path directory = fs::temp_directory_path() / ("elastisim-microbench-" + std::to_string(getpid()));
+	fs::path configuration = SyntheticScenario::writeConfiguration(directory, NUM_NODES, "rigid", NUM_JOBS, JOB_SIZE);
+	Configuration::init(configuration);
+	int engineArgc = 2;
+	char* engineArgv[] = {argv[0], (char*) "--log=root.thresh:critical", nullptr};
+	simgrid::s4u::Engine engine(&engineArgc, engineArgv);
+	simgrid::s4u::Engine::set_config("host/model:ptask_L07");
+	engine.load_platform(Configuration::get("platform_file"));
+
+	std::ofstream nodeUtilization("/dev/null");
+	std::ofstream taskTimes;
+	std::vector<std::unique_ptr<NodeClass>> nodeClasses;
+	nodeClasses.push_back(std::make_unique<NodeClass>(0, "compute", COMPUTE_NODE,
+													  std::vector<s4u_Host*>{engine.host_by_name("pfs")}, 0, 0, 0, 0,
+													  0, 0));
+	std::vector<std::unique_ptr<Node>> nodes;
+	for (int i = 0; i < NUM_NODES; ++i) {
+		nodes.push_back(std::make_unique<Node>(i, nodeClasses.front().get(),
+											   engine.host_by_name("node" + std::to_string(i)), nodeUtilization,
+											   taskTimes));
+	}
+	PlatformManager::init(std::move(nodeClasses), std::move(nodes));
+	PlatformManager::clearModifiedComputeNodes();
+
+	std::vector<std::unique_ptr<Job>> jobs = Utility::readJobs(Configuration::get("jobs_file"));
+	std::vector<Job*> jobQueue;
+	for (const auto& job: jobs) {
+		job->setId((int) jobQueue.size());
+		job->setState(PENDING);
+		jobQueue.push_back(job.get());
+	}
+	PlatformManager::clearModifiedJobs();
+
+	std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(17) << "Time"
+			  << std::setw(12) << "Iterations" << std::endl;
+	benchmarkFormulas();
+	benchmarkVectorsAndMatrices();
+	benchmarkSerialization(jobQueue);
+	benchmarkHandleSchedule(jobQueue);
+
+	fs::remove_all(directory);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "StubScheduler.h"
+
+#include <algorithm>
+#include <iostream>
+#include "SchedulingInterface.h"
+#include "Job.h"
+#include "Node.h"
+
+StubScheduler::StubScheduler(const std::string& url) : socket(context, zmq::socket_type::pair), url(url),
+														sharedMemory(SharedMemoryChannel::isSharedMemoryUrl(url)) {
+	if (!sharedMemory) {
+		socket.connect(url);
+	}
+}
+
+std::vector<int> StubScheduler::expandNodeIds(const nlohmann::json& jsonNodeIds) {
+	std::vector<int> nodeIds;
+	for (const auto& entry: jsonNodeIds) {
+		if (entry.is_array()) {
+			for (int id = entry[0]; id <= (int) entry[1]; ++id) {
+				nodeIds.push_back(id);
+			}
+		} else {
+			nodeIds.push_back(entry);
+		}
+	}
+	return nodeIds;
+}
+
+void StubScheduler::update(const nlohmann::json& message) {
+	for (const auto& node: message["nodes"]) {
+		int id = node["id"];
+		if (id >= (int) nodeStates.size()) {
+			nodeStates.resize(id + 1, NODE_ALLOCATED);
+		}
+		nodeStates[id] = node["state"];
+	}
+	for (const auto& job: message["jobs"]) {
+		if (job["state"] == COMPLETED || job["state"] == KILLED) {
+			jobs.erase((int) job["id"]);
+		} else {
+			jobs[(int) job["id"]] = job;
+		}
+	}
+}
+
+std::vector<int> StubScheduler::collectFreeNodes() const {
+	std::vector<bool> free(nodeStates.size());
+	for (size_t i = 0; i < nodeStates.size(); ++i) {
+		free[i] = nodeStates[i] == NODE_FREE;
+	}
+	for (const auto& [id, job]: jobs) {
+		for (int nodeId: expandNodeIds(job["assigned_nodes"])) {
+			free[nodeId] = false;
+		}
+	}
+	std::vector<int> freeNodes;
+	for (size_t i = 0; i < free.size(); ++i) {
+		if (free[i]) {
+			freeNodes.push_back((int) i);
+		}
+	}
+	return freeNodes;
+}
+
+nlohmann::json StubScheduler::schedule(const nlohmann::json& message) {
+	update(message);
+	std::vector<int> freeNodes = collectFreeNodes();
+	auto next = freeNodes.begin();
+	nlohmann::json scheduledJobs = nlohmann::json::array();
+
+	if (message["invocation_type"] == INVOKE_EVOLVING_REQUEST) {
+		const nlohmann::json& job = jobs.at((int) message["job_id"]);
+		std::vector<int> assigned = expandNodeIds(job["assigned_nodes"]);
+		int requested = message["evolving_request"];
+		requested = std::clamp(requested, (int) job["num_nodes_min"], (int) job["num_nodes_max"]);
+		if (requested < (int) assigned.size()) {
+			assigned.resize(requested);
+		} else {
+			int additional = std::min(requested - (int) assigned.size(), (int) (freeNodes.end() - next));
+			assigned.insert(assigned.end(), next, next + additional);
+			next += additional;
+		}
+		scheduledJobs.push_back({{"id", job["id"]}, {"kill_flag", false}, {"assigned_node_ids", assigned},
+								 {"assigned_num_gpus_per_node", job["assigned_num_gpus_per_node"]},
+								 {"modified_runtime_args", false}});
+	}
+
+	// strict first-come-first-served over pending jobs in submission order
+	for (const auto& [id, job]: jobs) {
+		if (job["state"] != PENDING) {
+			continue;
+		}
+		int available = (int) (freeNodes.end() - next);
+		nlohmann::json scheduledJob = {{"id", id}, {"kill_flag", false}, {"modified_runtime_args", false}};
+		int numNodes;
+		if (job["type"] == RIGID) {
+			numNodes = job["num_nodes"];
+			if (numNodes > (int) nodeStates.size()) {
+				scheduledJob["kill_flag"] = true;
+				scheduledJobs.push_back(scheduledJob);
+				continue;
+			}
+			if (numNodes > available) {
+				break;
+			}
+		} else {
+			if ((int) job["num_nodes_min"] > available) {
+				break;
+			}
+			numNodes = std::min((int) job["num_nodes_max"], available);
+			scheduledJob["assigned_num_gpus_per_node"] = job["num_gpus_per_node_min"];
+		}
+		scheduledJob["assigned_node_ids"] = std::vector<int>(next, next + numNodes);
+		next += numNodes;
+		scheduledJobs.push_back(scheduledJob);
+	}
+	return scheduledJobs;
+}
+
+void StubScheduler::operator()() {
+	// unlike connecting a ZeroMQ socket, attaching blocks until the simulator has created the segment
+	if (sharedMemory) {
+		channel.attach(url);
+	}
+	while (true) {
+		std::string message;
+		if (sharedMemory) {
+			message = channel.receive();
+		} else {
+			zmq::message_t zmqMessage;
+			if (!socket.recv(zmqMessage, zmq::recv_flags::none)) {
+				std::cerr << "Stub scheduler lost connection to the simulator" << std::endl;
+				return;
+			}
+			message = zmqMessage.to_string();
+		}
+		nlohmann::json json = nlohmann::json::parse(message);
+		if (json["code"] == ZMQ_FINALIZE) {
+			break;
+		}
+		nlohmann::json reply;
+		reply["code"] = ZMQ_SCHEDULED;
+		reply["jobs"] = schedule(json);
+		if (sharedMemory) {
+			channel.send(reply.dump());
+		} else {
+			socket.send(zmq::buffer(reply.dump()));
+		}
+	}
+	if (sharedMemory) {
+		channel.close();
+	} else {
+		socket.close();
+	}
+}
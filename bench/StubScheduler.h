@@ -0,0 +1,49 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_STUBSCHEDULER_H
+#define ELASTISIM_STUBSCHEDULER_H
+
+
+#include <map>
+#include <vector>
+#include <zmq.hpp>
+#include <json.hpp>
+#include "SharedMemoryChannel.h"
+
+// first-come-first-served scheduler speaking the ZeroMQ or shared-memory protocol from within the benchmark process
+class StubScheduler {
+
+private:
+	zmq::context_t context;
+	zmq::socket_t socket;
+	SharedMemoryChannel channel;
+	std::string url;
+	bool sharedMemory;
+	std::map<int, nlohmann::json> jobs;
+	std::vector<int> nodeStates;
+
+	[[nodiscard]] static std::vector<int> expandNodeIds(const nlohmann::json& jsonNodeIds);
+
+	void update(const nlohmann::json& message);
+
+	[[nodiscard]] std::vector<int> collectFreeNodes() const;
+
+	[[nodiscard]] nlohmann::json schedule(const nlohmann::json& message);
+
+public:
+	explicit StubScheduler(const std::string& url);
+
+	void operator()();
+
+};
+
+
+#endif //ELASTISIM_STUBSCHEDULER_H
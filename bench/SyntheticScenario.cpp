@@ -0,0 +1,129 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "SyntheticScenario.h"
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <json.hpp>
+
+namespace fs = std::filesystem;
+
+void SyntheticScenario::writePlatform(const fs::path& file, int numNodes) {
+	std::ofstream platform(file);
+	platform << "<?xml version='1.0'?>\n"
+			 << "<!DOCTYPE platform SYSTEM \"https://simgrid.org/simgrid.dtd\">\n"
+			 << "<platform version=\"4.1\">\n"
+			 << "\t<zone id=\"world\" routing=\"Floyd\">\n"
+			 << "\t\t<cluster id=\"compute\" prefix=\"node\" suffix=\"\" radical=\"0-" << numNodes - 1
+			 << "\" speed=\"1Tf\" bw=\"12.5GBps\" lat=\"1us\" bb_bw=\"100GBps\" bb_lat=\"1us\"/>\n"
+			 << "\t\t<zone id=\"service\" routing=\"Floyd\">\n"
+			 << "\t\t\t<host id=\"master\" speed=\"1Gf\">\n"
+			 << "\t\t\t\t<prop id=\"batch_system\" value=\"true\"/>\n"
+			 << "\t\t\t</host>\n"
+			 << "\t\t\t<host id=\"pfs\" speed=\"1Gf\">\n"
+			 << "\t\t\t\t<prop id=\"pfs_host\" value=\"true\"/>\n"
+			 << "\t\t\t</host>\n"
+			 << "\t\t\t<router id=\"service_router\"/>\n"
+			 << "\t\t\t<link id=\"master_link\" bandwidth=\"10GBps\" latency=\"1us\"/>\n"
+			 << "\t\t\t<link id=\"pfs_link\" bandwidth=\"100GBps\" latency=\"1us\"/>\n"
+			 << "\t\t\t<route src=\"master\" dst=\"service_router\"><link_ctn id=\"master_link\"/></route>\n"
+			 << "\t\t\t<route src=\"pfs\" dst=\"service_router\"><link_ctn id=\"pfs_link\"/></route>\n"
+			 << "\t\t</zone>\n"
+			 << "\t\t<link id=\"backbone\" bandwidth=\"200GBps\" latency=\"1us\"/>\n"
+			 << "\t\t<zoneRoute src=\"compute\" dst=\"service\" gw_src=\"nodecompute_router\" "
+			 << "gw_dst=\"service_router\"><link_ctn id=\"backbone\"/></zoneRoute>\n"
+			 << "\t</zone>\n"
+			 << "</platform>\n";
+}
+
+void SyntheticScenario::writeApplicationModel(const fs::path& file, const std::string& workload) {
+	nlohmann::json phase = {
+			{"iterations", 10},
+			{"tasks",      {
+								   {{"type", "cpu"}, {"flops", "1e12"}, {"computation_pattern", "uniform"},
+											   {"bytes", "1e7"}, {"communication_pattern", "ring"}},
+								   {{"type", "pfs_write"}, {"bytes", "1e8*num_nodes"}, {"pattern", "all_ranks"}}
+						   }}
+	};
+	nlohmann::json model;
+	model["on_init"]["tasks"] = {{{"type", "pfs_read"}, {"bytes", "1e8*num_nodes"}, {"pattern", "all_ranks"}}};
+	if (workload == "rigid") {
+		model["phases"] = {phase};
+	} else if (workload == "malleable") {
+		phase["iterations"] = 2;
+		model["phases"] = nlohmann::json::array();
+		for (int i = 0; i < 5; ++i) {
+			model["phases"].push_back(phase);
+		}
+	} else if (workload == "evolving") {
+		phase["iterations"] = 2;
+		model["phases"] = nlohmann::json::array();
+		for (int i = 0; i < 5; ++i) {
+			phase["evolving_request"] = i % 2 ? "max(1, floor(num_nodes / 2))" : "num_nodes * 2";
+			model["phases"].push_back(phase);
+		}
+	} else {
+		std::cerr << "Unknown synthetic workload " << workload << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	std::ofstream(file) << model.dump(4) << std::endl;
+}
+
+void SyntheticScenario::writeJobs(const fs::path& file, const fs::path& applicationModel, int numNodes,
+								  const std::string& workload, int numJobs, int jobSize) {
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> sizes(1, std::max(1, numNodes / 8));
+	std::exponential_distribution<double> interarrival(1.0 / 30);
+	nlohmann::json jobs = nlohmann::json::array();
+	double submitTime = 0;
+	for (int i = 0; i < numJobs; ++i) {
+		int size = jobSize > 0 ? jobSize : sizes(generator);
+		nlohmann::json job;
+		job["submit_time"] = submitTime;
+		job["application_model"] = applicationModel.string();
+		if (workload == "rigid") {
+			job["type"] = "rigid";
+			job["num_nodes"] = size;
+		} else {
+			job["type"] = workload;
+			job["num_nodes_min"] = std::max(1, size / 2);
+			job["num_nodes_max"] = std::min(numNodes, size * 2);
+		}
+		jobs.push_back(job);
+		submitTime += interarrival(generator);
+	}
+	std::ofstream(file) << nlohmann::json{{"jobs", jobs}}.dump() << std::endl;
+}
+
+fs::path SyntheticScenario::writeConfiguration(const fs::path& directory, int numNodes, const std::string& workload,
+											  int numJobs, int jobSize) {
+	fs::create_directories(directory);
+	writePlatform(directory / "platform.xml", numNodes);
+	writeApplicationModel(directory / "application.json", workload);
+	writeJobs(directory / "jobs.json", directory / "application.json", numNodes, workload, numJobs, jobSize);
+	nlohmann::json configuration;
+	configuration["platform_file"] = (directory / "platform.xml").string();
+	configuration["jobs_file"] = (directory / "jobs.json").string();
+	configuration["zmq_url"] = "ipc://" + (directory / "scheduler.ipc").string();
+	configuration["pfs_read_links"] = {"pfs_link"};
+	configuration["pfs_write_links"] = {"pfs_link"};
+	configuration["node_utilization"] = (directory / "node_utilization.csv").string();
+	configuration["job_statistics"] = (directory / "job_statistics.csv").string();
+	configuration["schedule_on_job_submit"] = true;
+	configuration["schedule_on_job_finalize"] = true;
+	configuration["compress_node_ids"] = true;
+	configuration["show_progress_bar"] = false;
+	configuration["profiling"] = true;
+	configuration["profiling_output"] = (directory / "profile.json").string();
+	std::ofstream(directory / "config.json") << configuration.dump(4) << std::endl;
+	return directory / "config.json";
+}
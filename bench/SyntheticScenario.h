@@ -0,0 +1,37 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_SYNTHETICSCENARIO_H
+#define ELASTISIM_SYNTHETICSCENARIO_H
+
+
+#include <filesystem>
+#include <string>
+
+// generates platforms, application models and job lists for the benchmark targets
+class SyntheticScenario {
+
+public:
+	static void writePlatform(const std::filesystem::path& file, int numNodes);
+
+	static void writeApplicationModel(const std::filesystem::path& file, const std::string& workload);
+
+	static void
+	writeJobs(const std::filesystem::path& file, const std::filesystem::path& applicationModel, int numNodes,
+			  const std::string& workload, int numJobs, int jobSize = 0);
+
+	[[nodiscard]] static std::filesystem::path
+	writeConfiguration(const std::filesystem::path& directory, int numNodes, const std::string& workload,
+					   int numJobs, int jobSize = 0);
+
+};
+
+
+#endif //ELASTISIM_SYNTHETICSCENARIO_H
@@ -0,0 +1,155 @@
+#
+# This file is part of the ElastiSim software.
+#
+# Copyright (c) 2022, Technical University of Darmstadt, Germany
+#
+# This software may be modified and distributed under the terms of the 3-Clause
+# BSD License. See the LICENSE file in the base directory for details.
+#
+
+"""Reference client for the shared-memory scheduling transport (zmq_url "shm://<name>").
+
+Implements the protocol of src/interface/SharedMemoryChannel.h, which documents the segment layout. Messages are
+the same JSON documents exchanged over ZeroMQ:
+
+    channel = SharedMemoryChannel("shm://elastisim")
+    while True:
+        message = json.loads(channel.receive())
+        if message["code"] == FINALIZE:
+            break
+        channel.send(json.dumps({"code": SCHEDULED, "jobs": schedule(message)}))
+    channel.close()
+"""
+
+import ctypes
+import mmap
+import os
+import platform
+import struct
+import time
+
+_SYS_FUTEX_NUMBERS = {"x86_64": 202, "aarch64": 98, "ppc64le": 221, "riscv64": 98}
+if platform.machine() not in _SYS_FUTEX_NUMBERS:
+    raise RuntimeError(f"unsupported architecture {platform.machine()} for the shared memory transport, "
+                       f"use a tcp:// or ipc:// zmq_url instead")
+_SYS_FUTEX = _SYS_FUTEX_NUMBERS[platform.machine()]
+_FUTEX_WAIT = 0
+_FUTEX_WAKE = 1
+
+_MAGIC = 0x454C5348
+_VERSION = 1
+_DATA_OFFSET = 4096
+_SPIN_ITERATIONS = 256
+
+_SEND_RING = 192
+_RECEIVE_RING = 64
+_HEAD = 0
+_HEAD_SIGNAL = 8
+_HEAD_WAITERS = 12
+_TAIL = 64
+_TAIL_SIGNAL = 72
+_TAIL_WAITERS = 76
+
+_libc = ctypes.CDLL(None, use_errno=True)
+
+
+class SharedMemoryChannel:
+
+    def __init__(self, url):
+        """Attaches to the segment of a running simulation, waiting until the simulator has created it."""
+        if not url.startswith("shm://"):
+            raise ValueError(f"Not a shared memory URL: {url}")
+        path = "/dev/shm/" + url[len("shm://"):]
+        while not os.path.exists(path) or os.path.getsize(path) <= _DATA_OFFSET:
+            time.sleep(0.01)
+        with open(path, "r+b") as file:
+            self._map = mmap.mmap(file.fileno(), 0)
+        while self._load32(0) != _MAGIC:
+            time.sleep(0.01)
+        version, self._capacity = struct.unpack_from("<IQ", self._map, 4)
+        if version != _VERSION:
+            raise RuntimeError(f"Unsupported shared memory protocol version {version}")
+        self._address = ctypes.addressof(ctypes.c_char.from_buffer(self._map))
+        # Python can not update the waiters counters atomically, so they are set once and never changed, which makes
+        # the simulator wake this client on every update; FUTEX_WAIT compares the signal again in the kernel
+        self._store32(_SEND_RING + _TAIL_WAITERS, 1)
+        self._store32(_RECEIVE_RING + _HEAD_WAITERS, 1)
+
+    def _load32(self, offset):
+        return struct.unpack_from("<I", self._map, offset)[0]
+
+    def _store32(self, offset, value):
+        struct.pack_into("<I", self._map, offset, value & 0xFFFFFFFF)
+
+    def _load64(self, offset):
+        return struct.unpack_from("<Q", self._map, offset)[0]
+
+    def _store64(self, offset, value):
+        struct.pack_into("<Q", self._map, offset, value)
+
+    def _futex(self, offset, operation, value):
+        _libc.syscall(_SYS_FUTEX, ctypes.c_void_p(self._address + offset), operation, value, None, None, 0)
+
+    def _wait(self, signal, value):
+        for _ in range(_SPIN_ITERATIONS):
+            if self._load32(signal) != value:
+                return
+        while self._load32(signal) == value:
+            self._futex(signal, _FUTEX_WAIT, value)
+
+    def _notify(self, signal):
+        # skipping the wake would need a full fence between the signal store and the waiters load (as the seq_cst
+        # accesses on the simulator side), which Python can not issue; the wake syscall orders both instead
+        self._store32(signal, self._load32(signal) + 1)
+        self._futex(signal, _FUTEX_WAKE, 0x7FFFFFFF)
+
+    def _write(self, payload):
+        ring = _SEND_RING
+        base = _DATA_OFFSET + self._capacity
+        head = self._load64(ring + _HEAD)
+        view = memoryview(payload)
+        position = 0
+        while position < len(payload):
+            signal = self._load32(ring + _TAIL_SIGNAL)
+            free = self._capacity - (head - self._load64(ring + _TAIL))
+            if free == 0:
+                self._wait(ring + _TAIL_SIGNAL, signal)
+                continue
+            offset = head % self._capacity
+            chunk = min(len(payload) - position, free, self._capacity - offset)
+            self._map[base + offset:base + offset + chunk] = view[position:position + chunk]
+            head += chunk
+            position += chunk
+            self._store64(ring + _HEAD, head)
+            self._notify(ring + _HEAD_SIGNAL)
+
+    def _read(self, size):
+        ring = _RECEIVE_RING
+        base = _DATA_OFFSET
+        tail = self._load64(ring + _TAIL)
+        chunks = []
+        while size > 0:
+            signal = self._load32(ring + _HEAD_SIGNAL)
+            available = self._load64(ring + _HEAD) - tail
+            if available == 0:
+                self._wait(ring + _HEAD_SIGNAL, signal)
+                continue
+            offset = tail % self._capacity
+            chunk = min(size, available, self._capacity - offset)
+            chunks.append(self._map[base + offset:base + offset + chunk])
+            tail += chunk
+            size -= chunk
+            self._store64(ring + _TAIL, tail)
+            self._notify(ring + _TAIL_SIGNAL)
+        return b"".join(chunks)
+
+    def send(self, message):
+        payload = message.encode() if isinstance(message, str) else message
+        self._write(struct.pack("<Q", len(payload)) + payload)
+
+    def receive(self):
+        size = struct.unpack("<Q", self._read(8))[0]
+        return self._read(size).decode()
+
+    def close(self):
+        self._map.close()
@@ -11,17 +11,24 @@
 #include "ElastiSim.h"
 
 #include <simgrid/s4u.hpp>
-#include <xbt/parse_units.hpp>
-#include <sstream>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "PlatformManager.h"
+#include "PlatformGenerator.h"
 #include "SimulationEngine.h"
 #include "Scheduler.h"
 #include "Node.h"
 #include "Sensing.h"
 #include "JobSubmitter.h"
 #include "Configuration.h"
+#include "Profiler.h"
+#include "Communication.h"
+#include "Utility.h"
+#include "Workload.h"
+#include "Phase.h"
+#include "Task.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(ElastiSim, "Messages within ElastiSim");
 
@@ -36,10 +43,16 @@ std::string ElastiSim::getPropertyIfExists(const char* property) {
 void ElastiSim::startSimulation(int argc, char* argv[]) {
 
 	Configuration::init(argv[1]);
+	Profiler::init();
 
 	simgrid::s4u::Engine engine(&argc, argv);
-	simgrid::s4u::Engine::set_config("host/model:ptask_L07");
-	engine.load_platform(Configuration::get("platform_file"));
+	Communication::init();
+	auto start = Profiler::now();
+	if (Configuration::exists("platform")) {
+		PlatformGenerator::generate(Configuration::get("platform"));
+	} else {
+		engine.load_platform(Configuration::get("platform_file"));
+	}
 
 	std::ofstream nodeUtilization(Configuration::get("node_utilization"));
 	nodeUtilization << "Time,Node,State,Running jobs,Expected jobs" << std::endl;
@@ -71,77 +84,50 @@ void ElastiSim::startSimulation(int argc, char* argv[]) {
 		}
 	}
 
+	// hosts with identical properties share a single node class, declared classes are keyed by their name
+	std::vector<std::unique_ptr<NodeClass>> nodeClasses;
+	std::unordered_map<std::string, const NodeClass*> nodeClassesByKey;
+	std::unordered_set<std::string> nodeClassNames;
 	std::vector<std::unique_ptr<Node>> nodes;
+	nodes.reserve(filteredHosts.size());
 	int id = 0;
 	for (const auto& host: filteredHosts) {
-
-		const std::string& hostname = host->get_name();
-
-		std::vector<s4u_Host*> pfsTargets;
-		if (host->get_property("pfs_targets")) {
-			std::stringstream stream(host->get_property("pfs_targets"));
-			while (stream.good()) {
-				std::string pfsHostname;
-				getline(stream, pfsHostname, ',');
-				pfsTargets.push_back(engine.host_by_name(pfsHostname));
-			}
+		std::string key;
+		if (const char* declaredName = host->get_property("node_class")) {
+			key = "name:" + std::string(declaredName);
 		} else {
-			pfsTargets = filteredPfs;
-		}
-
-		int numGpus = 0;
-		long flopsPerGpu = 0;
-		long gpuToGpuBandwidth = 0;
-		if (host->get_property("num_gpus")) {
-			numGpus = std::stoi(host->get_property("num_gpus"));
-			flopsPerGpu = (long) xbt_parse_get_speed("", 0, host->get_property("flops_per_gpu"), "");
-			if (numGpus > 1) {
-				gpuToGpuBandwidth = (long) xbt_parse_get_bandwidth("", 0, host->get_property("gpu_to_gpu_bw"), "");
-			}
+			key = NodeClass::describe(host);
 		}
-		std::vector<std::unique_ptr<Gpu>> gpus;
-		gpus.reserve(numGpus);
-		for (int i = 0; i < numGpus; ++i) {
-			gpus.push_back(std::make_unique<Gpu>(i, flopsPerGpu, host));
+		auto [it, inserted] = nodeClassesByKey.emplace(std::move(key), nullptr);
+		if (inserted) {
+			nodeClasses.push_back(
+					NodeClass::fromHost((int) nodeClasses.size(), host, filteredPfs, nodeClassNames));
+			nodeClassNames.insert(nodeClasses.back()->getName());
+			it->second = nodeClasses.back().get();
 		}
-
-		if (getPropertyIfExists(host->get_property("node_local_bb")) == "true") {
-			s4u_Disk* disk = host->create_disk("BurstBuffer@" + hostname, host->get_property("bb_read_bw"),
-											   host->get_property("bb_write_bw"));
-			disk->seal();
-			if (getPropertyIfExists(host->get_property("wide_striping")) == "true") {
-
-				double flopsPerByte = 0;
-				if (host->get_property("flops_per_byte")) {
-					flopsPerByte = xbt_parse_get_speed("", 0, host->get_property("flops_per_byte"), "");
-				}
-				nodes.emplace_back(
-						std::make_unique<Node>(id++, COMPUTE_NODE_WITH_WIDE_STRIPED_BB, host, disk, pfsTargets,
-											   flopsPerByte, std::move(gpus), gpuToGpuBandwidth, nodeUtilization, taskTimes));
-			} else {
-				nodes.emplace_back(
-						std::make_unique<Node>(id++, COMPUTE_NODE_WITH_BB, host, disk, pfsTargets, 0, std::move(gpus),
-											   gpuToGpuBandwidth, nodeUtilization, taskTimes));
-			}
-		} else {
-			nodes.emplace_back(
-					std::make_unique<Node>(id++, COMPUTE_NODE, host, nullptr, pfsTargets, 0, std::move(gpus),
-										   gpuToGpuBandwidth, nodeUtilization, taskTimes));
-		}
-
+		nodes.emplace_back(std::make_unique<Node>(id++, it->second, host, nodeUtilization, taskTimes));
 	}
 
-	PlatformManager::init(std::move(nodes));
+	PlatformManager::init(std::move(nodeClasses), std::move(nodes));
+	Profiler::record(PROFILE_PLATFORM, start);
+
+	// jobs and workloads are instantiated in parallel before the simulation starts
+	start = Profiler::now();
+	std::vector<std::unique_ptr<Job>> jobs = Utility::readJobs(Configuration::get("jobs_file"));
+	Profiler::record(PROFILE_PARSING, start);
 
 	if (!masterHost) {
 		masterHost = hosts.front();
 	}
-	s4u_Actor::create("JobSubmitter", masterHost, JobSubmitter());
+	s4u_Actor::create("JobSubmitter", masterHost, JobSubmitter(std::move(jobs)));
 	s4u_Actor::create("SimulationEngine", masterHost, SimulationEngine());
 	s4u_Actor::create("Scheduler", masterHost, Scheduler(masterHost));
 	if (Configuration::getBoolIfExists("sensing")) {
 		s4u_Actor::create("Sensing", masterHost, Sensing());
 	}
 
+	start = Profiler::now();
 	engine.run();
+	Profiler::record(PROFILE_SIMULATION, start);
+	Profiler::writeSummary();
 }
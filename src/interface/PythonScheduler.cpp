@@ -0,0 +1,620 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "PythonScheduler.h"
+
+#include <filesystem>
+#include "Job.h"
+#include "Node.h"
+#include "Gpu.h"
+#include "PlatformManager.h"
+#include "SchedulingInterface.h"
+#include "Configuration.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(PythonScheduler, "Messages within the embedded Python scheduler");
+
+struct JobView {
+	PyObject_HEAD
+	int id;
+	Job* job;
+	SchedulingDecision* decision;
+};
+
+struct NodeView {
+	PyObject_HEAD
+	Node* node;
+};
+
+enum JobAttribute {
+	JOB_ID,
+	JOB_TYPE,
+	JOB_STATE,
+	JOB_WALLTIME,
+	JOB_NUM_NODES,
+	JOB_NUM_GPUS_PER_NODE,
+	JOB_NUM_NODES_MIN,
+	JOB_NUM_NODES_MAX,
+	JOB_NUM_GPUS_PER_NODE_MIN,
+	JOB_NUM_GPUS_PER_NODE_MAX,
+	JOB_SUBMIT_TIME,
+	JOB_START_TIME,
+	JOB_END_TIME,
+	JOB_WAIT_TIME,
+	JOB_MAKESPAN,
+	JOB_TURNAROUND_TIME,
+	JOB_ASSIGNED_NODES,
+	JOB_ASSIGNED_NUM_GPUS_PER_NODE,
+	JOB_ARGUMENTS,
+	JOB_ATTRIBUTES,
+	JOB_RUNTIME_ARGUMENTS,
+	JOB_TOTAL_PHASE_COUNT,
+	JOB_COMPLETED_PHASES
+};
+
+enum NodeAttribute {
+	NODE_ID,
+	NODE_TYPE,
+	NODE_STATE,
+	NODE_ASSIGNED_JOBS,
+	NODE_GPUS
+};
+
+PyObject* PythonScheduler::function = nullptr;
+PyObject* PythonScheduler::jobViewType = nullptr;
+PyObject* PythonScheduler::nodeViewType = nullptr;
+PyObject* PythonScheduler::nodeViews = nullptr;
+std::map<int, PyObject*> PythonScheduler::jobViews;
+std::vector<PyObject*> PythonScheduler::decidedJobs;
+PyThreadState* PythonScheduler::threadState = nullptr;
+bool PythonScheduler::forwardIoInformation = false;
+
+PyModuleDef PythonScheduler::moduleDefinition = {PyModuleDef_HEAD_INIT, "elastisim",
+												 "Views onto the jobs and nodes of the running simulation", -1,
+												 nullptr};
+
+PyGetSetDef PythonScheduler::jobViewAttributes[] = {
+		{"id", getJobAttribute, nullptr, nullptr, (void*) JOB_ID},
+		{"type", getJobAttribute, nullptr, nullptr, (void*) JOB_TYPE},
+		{"state", getJobAttribute, nullptr, nullptr, (void*) JOB_STATE},
+		{"walltime", getJobAttribute, nullptr, nullptr, (void*) JOB_WALLTIME},
+		{"num_nodes", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_NODES},
+		{"num_gpus_per_node", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_GPUS_PER_NODE},
+		{"num_nodes_min", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_NODES_MIN},
+		{"num_nodes_max", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_NODES_MAX},
+		{"num_gpus_per_node_min", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_GPUS_PER_NODE_MIN},
+		{"num_gpus_per_node_max", getJobAttribute, nullptr, nullptr, (void*) JOB_NUM_GPUS_PER_NODE_MAX},
+		{"submit_time", getJobAttribute, nullptr, nullptr, (void*) JOB_SUBMIT_TIME},
+		{"start_time", getJobAttribute, nullptr, nullptr, (void*) JOB_START_TIME},
+		{"end_time", getJobAttribute, nullptr, nullptr, (void*) JOB_END_TIME},
+		{"wait_time", getJobAttribute, nullptr, nullptr, (void*) JOB_WAIT_TIME},
+		{"makespan", getJobAttribute, nullptr, nullptr, (void*) JOB_MAKESPAN},
+		{"turnaround_time", getJobAttribute, nullptr, nullptr, (void*) JOB_TURNAROUND_TIME},
+		{"assigned_nodes", getJobAttribute, nullptr, nullptr, (void*) JOB_ASSIGNED_NODES},
+		{"assigned_num_gpus_per_node", getJobAttribute, nullptr, nullptr, (void*) JOB_ASSIGNED_NUM_GPUS_PER_NODE},
+		{"arguments", getJobAttribute, nullptr, nullptr, (void*) JOB_ARGUMENTS},
+		{"attributes", getJobAttribute, nullptr, nullptr, (void*) JOB_ATTRIBUTES},
+		{"runtime_arguments", getJobAttribute, nullptr, nullptr, (void*) JOB_RUNTIME_ARGUMENTS},
+		{"total_phase_count", getJobAttribute, nullptr, nullptr, (void*) JOB_TOTAL_PHASE_COUNT},
+		{"completed_phases", getJobAttribute, nullptr, nullptr, (void*) JOB_COMPLETED_PHASES},
+		{nullptr}
+};
+
+PyMethodDef PythonScheduler::jobViewMethods[] = {
+		{"assign", assignNodes, METH_O, "Assigns the given nodes or node IDs to the job"},
+		{"assign_num_gpus_per_node", assignNumGpusPerNode, METH_O, "Assigns the number of GPUs per node"},
+		{"kill", killJob, METH_NOARGS, "Kills the job"},
+		{"suspend", (PyCFunction) (void (*)()) suspendJob, METH_VARARGS | METH_KEYWORDS,
+		 "Suspends the job, optionally retaining its nodes"},
+		{"resume", resumeJob, METH_NOARGS, "Resumes the suspended job on its assigned nodes"},
+		{"set_runtime_argument", setRuntimeArgument, METH_VARARGS, "Sets a runtime argument of the job"},
+		{"estimate_runtime", estimateRuntime, METH_VARARGS,
+		 "Estimates the remaining runtime for the given number of nodes and GPUs per node"},
+		{nullptr}
+};
+
+PyType_Slot PythonScheduler::jobViewSlots[] = {
+		{Py_tp_dealloc, (void*) deallocateJobView},
+		{Py_tp_repr, (void*) representJob},
+		{Py_tp_getset, jobViewAttributes},
+		{Py_tp_methods, jobViewMethods},
+		{0, nullptr}
+};
+
+PyType_Spec PythonScheduler::jobViewSpec = {"elastisim.Job", sizeof(JobView), 0, Py_TPFLAGS_DEFAULT, jobViewSlots};
+
+PyGetSetDef PythonScheduler::nodeViewAttributes[] = {
+		{"id", getNodeAttribute, nullptr, nullptr, (void*) NODE_ID},
+		{"type", getNodeAttribute, nullptr, nullptr, (void*) NODE_TYPE},
+		{"state", getNodeAttribute, nullptr, nullptr, (void*) NODE_STATE},
+		{"assigned_jobs", getNodeAttribute, nullptr, nullptr, (void*) NODE_ASSIGNED_JOBS},
+		{"gpus", getNodeAttribute, nullptr, nullptr, (void*) NODE_GPUS},
+		{nullptr}
+};
+
+PyType_Slot PythonScheduler::nodeViewSlots[] = {
+		{Py_tp_dealloc, (void*) deallocateNodeView},
+		{Py_tp_repr, (void*) representNode},
+		{Py_tp_getset, nodeViewAttributes},
+		{0, nullptr}
+};
+
+PyType_Spec PythonScheduler::nodeViewSpec = {"elastisim.Node", sizeof(NodeView), 0, Py_TPFLAGS_DEFAULT,
+											 nodeViewSlots};
+
+static PyObject* toDict(const std::map<std::string, std::string>& map) {
+	PyObject* dict = PyDict_New();
+	for (const auto& [key, value]: map) {
+		PyObject* item = PyUnicode_FromString(value.c_str());
+		PyDict_SetItemString(dict, key.c_str(), item);
+		Py_DECREF(item);
+	}
+	return dict;
+}
+
+PyObject* PythonScheduler::createModule() {
+	PyObject* module = PyModule_Create(&moduleDefinition);
+	jobViewType = PyType_FromSpec(&jobViewSpec);
+	nodeViewType = PyType_FromSpec(&nodeViewSpec);
+	if (!module || !jobViewType || !nodeViewType) {
+		return nullptr;
+	}
+	Py_INCREF(jobViewType);
+	PyModule_AddObject(module, "Job", jobViewType);
+	Py_INCREF(nodeViewType);
+	PyModule_AddObject(module, "Node", nodeViewType);
+	const std::pair<const char*, long> constants[] = {
+			{"RIGID", RIGID}, {"MOLDABLE", MOLDABLE}, {"MALLEABLE", MALLEABLE}, {"EVOLVING", EVOLVING},
+			{"ADAPTIVE", ADAPTIVE}, {"PENDING_SUBMISSION", PENDING_SUBMISSION}, {"PENDING", PENDING},
+			{"PENDING_ALLOCATION", PENDING_ALLOCATION}, {"PENDING_KILL", PENDING_KILL}, {"RUNNING", RUNNING},
+			{"PENDING_RECONFIGURATION", PENDING_RECONFIGURATION}, {"IN_RECONFIGURATION", IN_RECONFIGURATION},
+			{"COMPLETED", COMPLETED}, {"KILLED", KILLED}, {"PENDING_SUSPENSION", PENDING_SUSPENSION},
+			{"SUSPENDED", SUSPENDED}, {"PENDING_RESUMPTION", PENDING_RESUMPTION}, {"NODE_FREE", NODE_FREE},
+			{"NODE_ALLOCATED", NODE_ALLOCATED}, {"NODE_RESERVED", NODE_RESERVED},
+			{"INVOKE_PERIODIC", INVOKE_PERIODIC}, {"INVOKE_JOB_SUBMIT", INVOKE_JOB_SUBMIT},
+			{"INVOKE_JOB_COMPLETED", INVOKE_JOB_COMPLETED}, {"INVOKE_JOB_KILLED", INVOKE_JOB_KILLED},
+			{"INVOKE_SCHEDULING_POINT", INVOKE_SCHEDULING_POINT},
+			{"INVOKE_EVOLVING_REQUEST", INVOKE_EVOLVING_REQUEST},
+			{"INVOKE_RECONFIGURATION", INVOKE_RECONFIGURATION}
+	};
+	for (const auto& [name, value]: constants) {
+		PyModule_AddIntConstant(module, name, value);
+	}
+	return module;
+}
+
+PyObject* PythonScheduler::getJobView(Job* job) {
+	auto it = jobViews.find(job->getId());
+	if (it != jobViews.end()) {
+		return it->second;
+	}
+	JobView* view = PyObject_New(JobView, (PyTypeObject*) jobViewType);
+	view->id = job->getId();
+	view->job = job;
+	view->decision = nullptr;
+	jobViews[view->id] = (PyObject*) view;
+	return (PyObject*) view;
+}
+
+Job* PythonScheduler::getJob(PyObject* self) {
+	auto view = (JobView*) self;
+	if (!view->job) {
+		PyErr_Format(PyExc_RuntimeError, "Job %d has already finished", view->id);
+	}
+	return view->job;
+}
+
+SchedulingDecision* PythonScheduler::getDecision(PyObject* self) {
+	auto view = (JobView*) self;
+	Job* job = getJob(self);
+	if (!job) {
+		return nullptr;
+	}
+	// jobs keep their current configuration unless the algorithm changes it
+	if (!view->decision) {
+		view->decision = new SchedulingDecision();
+		view->decision->assignedNodes = job->getAssignedNodes();
+		view->decision->assignedNumGpusPerNode = job->getAssignedNumGpusPerNode();
+		view->decision->runtimeArguments = job->getRuntimeArguments();
+		Py_INCREF(self);
+		decidedJobs.push_back(self);
+	}
+	return view->decision;
+}
+
+PyObject* PythonScheduler::getJobAttribute(PyObject* self, void* attribute) {
+	Job* job = getJob(self);
+	if (!job) {
+		return nullptr;
+	}
+	switch ((JobAttribute) (intptr_t) attribute) {
+		case JOB_ID:
+			return PyLong_FromLong(job->getId());
+		case JOB_TYPE:
+			return PyLong_FromLong(job->getType());
+		case JOB_STATE:
+			return PyLong_FromLong(job->getState());
+		case JOB_WALLTIME:
+			return PyFloat_FromDouble(job->getWalltime());
+		case JOB_NUM_NODES:
+			return PyLong_FromLong(job->getNumNodes());
+		case JOB_NUM_GPUS_PER_NODE:
+			return PyLong_FromLong(job->getNumGpusPerNode());
+		case JOB_NUM_NODES_MIN:
+			return PyLong_FromLong(job->getNumNodesMin());
+		case JOB_NUM_NODES_MAX:
+			return PyLong_FromLong(job->getNumNodesMax());
+		case JOB_NUM_GPUS_PER_NODE_MIN:
+			return PyLong_FromLong(job->getNumGpusPerNodeMin());
+		case JOB_NUM_GPUS_PER_NODE_MAX:
+			return PyLong_FromLong(job->getNumGpusPerNodeMax());
+		case JOB_SUBMIT_TIME:
+			return PyFloat_FromDouble(job->getSubmitTime());
+		case JOB_START_TIME:
+			return PyFloat_FromDouble(job->getStartTime());
+		case JOB_END_TIME:
+			return PyFloat_FromDouble(job->getEndTime());
+		case JOB_WAIT_TIME:
+			return PyFloat_FromDouble(job->getWaitTime());
+		case JOB_MAKESPAN:
+			return PyFloat_FromDouble(job->getMakespan());
+		case JOB_TURNAROUND_TIME:
+			return PyFloat_FromDouble(job->getTurnaroundTime());
+		case JOB_ASSIGNED_NODES: {
+			const std::vector<Node*>& nodes = job->getAssignedNodes();
+			PyObject* list = PyList_New((Py_ssize_t) nodes.size());
+			for (size_t i = 0; i < nodes.size(); ++i) {
+				PyObject* view = PyTuple_GET_ITEM(nodeViews, nodes[i]->getId());
+				Py_INCREF(view);
+				PyList_SET_ITEM(list, (Py_ssize_t) i, view);
+			}
+			return list;
+		}
+		case JOB_ASSIGNED_NUM_GPUS_PER_NODE:
+			return PyLong_FromLong(job->getAssignedNumGpusPerNode());
+		case JOB_ARGUMENTS:
+			return toDict(job->getArguments());
+		case JOB_ATTRIBUTES:
+			return toDict(job->getAttributes());
+		case JOB_RUNTIME_ARGUMENTS:
+			return toDict(job->getRuntimeArguments());
+		case JOB_TOTAL_PHASE_COUNT:
+			return PyLong_FromLong(job->getTotalPhaseCount());
+		case JOB_COMPLETED_PHASES:
+			return PyLong_FromLong(job->getCompletedPhases());
+		default:
+			Py_RETURN_NONE;
+	}
+}
+
+PyObject* PythonScheduler::assignNodes(PyObject* self, PyObject* nodes) {
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	PyObject* sequence = PySequence_Fast(nodes, "Assigned nodes must be a sequence of nodes or node IDs");
+	if (!sequence) {
+		return nullptr;
+	}
+	Py_ssize_t numNodes = PySequence_Fast_GET_SIZE(sequence);
+	Py_ssize_t numComputeNodes = PyTuple_GET_SIZE(nodeViews);
+	std::vector<Node*> assignedNodes;
+	assignedNodes.reserve(numNodes);
+	for (Py_ssize_t i = 0; i < numNodes; ++i) {
+		PyObject* item = PySequence_Fast_GET_ITEM(sequence, i);
+		if (Py_TYPE(item) == (PyTypeObject*) nodeViewType) {
+			assignedNodes.push_back(((NodeView*) item)->node);
+			continue;
+		}
+		long id = PyLong_AsLong(item);
+		if (id == -1 && PyErr_Occurred()) {
+			Py_DECREF(sequence);
+			return nullptr;
+		}
+		if (id < 0 || id >= numComputeNodes) {
+			Py_DECREF(sequence);
+			return PyErr_Format(PyExc_IndexError, "Node %ld does not exist", id);
+		}
+		assignedNodes.push_back(((NodeView*) PyTuple_GET_ITEM(nodeViews, id))->node);
+	}
+	Py_DECREF(sequence);
+	decision->kill = false;
+	decision->suspend = false;
+	decision->assignedNodes = std::move(assignedNodes);
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::assignNumGpusPerNode(PyObject* self, PyObject* numGpusPerNode) {
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	long value = PyLong_AsLong(numGpusPerNode);
+	if (value == -1 && PyErr_Occurred()) {
+		return nullptr;
+	}
+	decision->assignedNumGpusPerNode = (int) value;
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::killJob(PyObject* self, PyObject* unused) {
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	decision->kill = true;
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::suspendJob(PyObject* self, PyObject* arguments, PyObject* keywords) {
+	static const char* keywordList[] = {"retain_nodes", nullptr};
+	int retainNodes = 0;
+	if (!PyArg_ParseTupleAndKeywords(arguments, keywords, "|p", (char**) keywordList, &retainNodes)) {
+		return nullptr;
+	}
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	JobState state = getJob(self)->getState();
+	if (state != RUNNING && state != PENDING_RECONFIGURATION && state != SUSPENDED) {
+		return PyErr_Format(PyExc_RuntimeError, "Job %d is not running and can not be suspended",
+							getJob(self)->getId());
+	}
+	decision->suspend = true;
+	decision->retainNodes = retainNodes;
+	decision->resume = false;
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::resumeJob(PyObject* self, PyObject* unused) {
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	decision->suspend = false;
+	decision->resume = true;
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::setRuntimeArgument(PyObject* self, PyObject* arguments) {
+	const char* key;
+	PyObject* value;
+	if (!PyArg_ParseTuple(arguments, "sO", &key, &value)) {
+		return nullptr;
+	}
+	SchedulingDecision* decision = getDecision(self);
+	if (!decision) {
+		return nullptr;
+	}
+	PyObject* string = PyObject_Str(value);
+	if (!string) {
+		return nullptr;
+	}
+	decision->modifiedRuntimeArguments = true;
+	decision->runtimeArguments[key] = PyUnicode_AsUTF8(string);
+	Py_DECREF(string);
+	Py_RETURN_NONE;
+}
+
+PyObject* PythonScheduler::estimateRuntime(PyObject* self, PyObject* arguments) {
+	int numNodes;
+	int numGpusPerNode = 0;
+	if (!PyArg_ParseTuple(arguments, "i|i", &numNodes, &numGpusPerNode)) {
+		return nullptr;
+	}
+	Job* job = getJob(self);
+	if (!job) {
+		return nullptr;
+	}
+	return PyFloat_FromDouble(job->estimateRuntime(numNodes, numGpusPerNode));
+}
+
+PyObject* PythonScheduler::representJob(PyObject* self) {
+	return PyUnicode_FromFormat("<elastisim.Job %d>", ((JobView*) self)->id);
+}
+
+void PythonScheduler::deallocateJobView(PyObject* self) {
+	PyTypeObject* type = Py_TYPE(self);
+	delete ((JobView*) self)->decision;
+	PyObject_Free(self);
+	Py_DECREF(type);
+}
+
+PyObject* PythonScheduler::getNodeAttribute(PyObject* self, void* attribute) {
+	Node* node = ((NodeView*) self)->node;
+	switch ((NodeAttribute) (intptr_t) attribute) {
+		case NODE_ID:
+			return PyLong_FromLong(node->getId());
+		case NODE_TYPE:
+			return PyLong_FromLong(node->getType());
+		case NODE_STATE:
+			return PyLong_FromLong(node->getState());
+		case NODE_ASSIGNED_JOBS: {
+			PyObject* list = PyList_New(0);
+			for (const auto& job: node->getRunningJobs()) {
+				PyObject* id = PyLong_FromLong(job->getId());
+				PyList_Append(list, id);
+				Py_DECREF(id);
+			}
+			return list;
+		}
+		case NODE_GPUS: {
+			const std::vector<const Gpu*>& gpus = node->getGpus();
+			PyObject* list = PyList_New((Py_ssize_t) gpus.size());
+			for (size_t i = 0; i < gpus.size(); ++i) {
+				PyList_SET_ITEM(list, (Py_ssize_t) i,
+								Py_BuildValue("{s:n,s:i}", "id", (Py_ssize_t) i, "state", (int) gpus[i]->getState()));
+			}
+			return list;
+		}
+		default:
+			Py_RETURN_NONE;
+	}
+}
+
+PyObject* PythonScheduler::representNode(PyObject* self) {
+	return PyUnicode_FromFormat("<elastisim.Node %d>", ((NodeView*) self)->node->getId());
+}
+
+void PythonScheduler::deallocateNodeView(PyObject* self) {
+	PyTypeObject* type = Py_TYPE(self);
+	PyObject_Free(self);
+	Py_DECREF(type);
+}
+
+void PythonScheduler::init(const std::string& module) {
+	PyImport_AppendInittab("elastisim", &createModule);
+	Py_Initialize();
+
+	// a path to a Python file is imported from its directory, anything else is imported as a module name
+	std::filesystem::path path(module);
+	std::string moduleName = module;
+	if (path.extension() == ".py") {
+		PyObject* directory = PyUnicode_FromString(std::filesystem::absolute(path).parent_path().c_str());
+		PyList_Insert(PySys_GetObject("path"), 0, directory);
+		Py_DECREF(directory);
+		moduleName = path.stem().string();
+	}
+	PyObject* imported = PyImport_ImportModule("elastisim");
+	Py_XDECREF(imported);
+	imported = PyImport_ImportModule(moduleName.c_str());
+	if (!imported) {
+		PyErr_Print();
+		xbt_die("Could not import Python scheduling algorithm %s", module.c_str());
+	}
+	function = PyObject_GetAttrString(imported, "schedule");
+	Py_DECREF(imported);
+	if (!function || !PyCallable_Check(function)) {
+		PyErr_Clear();
+		xbt_die("Python scheduling algorithm %s does not define a schedule(jobs, nodes, system) function",
+				module.c_str());
+	}
+
+	// node views never change and are handed over as the same tuple on every invocation
+	const std::vector<Node*>& nodes = PlatformManager::getComputeNodes();
+	nodeViews = PyTuple_New((Py_ssize_t) nodes.size());
+	for (const auto& node: nodes) {
+		NodeView* view = PyObject_New(NodeView, (PyTypeObject*) nodeViewType);
+		view->node = node;
+		PyTuple_SET_ITEM(nodeViews, node->getId(), (PyObject*) view);
+	}
+	forwardIoInformation = Configuration::getBoolIfExists("forward_io_information");
+	XBT_INFO("Embedded Python scheduling algorithm %s", module.c_str());
+	threadState = PyEval_SaveThread();
+}
+
+std::vector<Job*>
+PythonScheduler::schedule(InvocationType invocationType, const std::vector<Job*>& jobQueue,
+						  const std::vector<Job*>& modifiedJobs, const Job* requestingJob, int numberOfNodes,
+						  SchedulingTiming& timing) {
+	auto start = Profiler::now();
+	PyGILState_STATE state = PyGILState_Ensure();
+
+	// job views persist across invocations, finished jobs are handed over a last time before their views expire
+	for (const auto& job: modifiedJobs) {
+		getJobView(job);
+	}
+	PyObject* jobs = PyList_New((Py_ssize_t) jobViews.size());
+	Py_ssize_t index = 0;
+	for (const auto& [id, view]: jobViews) {
+		Py_INCREF(view);
+		PyList_SET_ITEM(jobs, index++, view);
+	}
+	PyObject* system = PyDict_New();
+	PyObject* value = PyFloat_FromDouble(simgrid::s4u::Engine::get_clock());
+	PyDict_SetItemString(system, "time", value);
+	Py_DECREF(value);
+	value = PyLong_FromLong(invocationType);
+	PyDict_SetItemString(system, "invocation_type", value);
+	Py_DECREF(value);
+	if (invocationType != INVOKE_PERIODIC) {
+		PyDict_SetItemString(system, "job", getJobView(const_cast<Job*>(requestingJob)));
+		if (invocationType == INVOKE_EVOLVING_REQUEST) {
+			value = PyLong_FromLong(numberOfNodes);
+			PyDict_SetItemString(system, "evolving_request", value);
+			Py_DECREF(value);
+		}
+	}
+	if (forwardIoInformation) {
+		const std::pair<const char*, double> ioInformation[] = {
+				{"pfs_read_bw", PlatformManager::getPfsReadBandwidth()},
+				{"pfs_write_bw", PlatformManager::getPfsWriteBandwidth()},
+				{"pfs_read_utilization", PlatformManager::getPfsReadUtilization()},
+				{"pfs_write_utilization", PlatformManager::getPfsWriteUtilization()}
+		};
+		for (const auto& [key, number]: ioInformation) {
+			value = PyFloat_FromDouble(number);
+			PyDict_SetItemString(system, key, value);
+			Py_DECREF(value);
+		}
+	}
+	timing.durations[STAGE_BUILD] = Profiler::elapsed(start);
+
+	start = Profiler::now();
+	PyObject* result = PyObject_CallFunctionObjArgs(function, jobs, nodeViews, system, nullptr);
+	if (!result) {
+		PyErr_Print();
+		xbt_die("Python scheduling algorithm raised an exception");
+	}
+	Py_DECREF(result);
+	Py_DECREF(jobs);
+	Py_DECREF(system);
+	timing.durations[STAGE_WAIT] = Profiler::elapsed(start);
+
+	start = Profiler::now();
+	std::vector<std::pair<int, SchedulingDecision>> decisions;
+	decisions.reserve(decidedJobs.size());
+	for (const auto& object: decidedJobs) {
+		auto view = (JobView*) object;
+		decisions.emplace_back(view->id, std::move(*view->decision));
+		delete view->decision;
+		view->decision = nullptr;
+		Py_DECREF(object);
+	}
+	decidedJobs.clear();
+	for (const auto& job: modifiedJobs) {
+		if (job->getState() == COMPLETED || job->getState() == KILLED) {
+			auto it = jobViews.find(job->getId());
+			((JobView*) it->second)->job = nullptr;
+			Py_DECREF(it->second);
+			jobViews.erase(it);
+		}
+	}
+	PyGILState_Release(state);
+
+	// released jobs are freed here, decisions thus refer to jobs by their ID
+	PlatformManager::clearModifiedJobs();
+	PlatformManager::clearModifiedComputeNodes();
+	std::vector<Job*> scheduledJobs;
+	for (const auto& [id, decision]: decisions) {
+		Job* job = jobQueue[id];
+		if (!job) {
+			xbt_die("Job %d has already finished and can not be scheduled", id);
+		}
+		SchedulingInterface::applyDecision(job, decision);
+		scheduledJobs.push_back(job);
+	}
+	timing.durations[STAGE_APPLY] = Profiler::elapsed(start);
+	return scheduledJobs;
+}
+
+void PythonScheduler::finalize() {
+	PyEval_RestoreThread(threadState);
+	for (const auto& [id, view]: jobViews) {
+		((JobView*) view)->job = nullptr;
+		Py_DECREF(view);
+	}
+	jobViews.clear();
+	Py_CLEAR(nodeViews);
+	Py_CLEAR(function);
+	Py_CLEAR(jobViewType);
+	Py_CLEAR(nodeViewType);
+	Py_FinalizeEx();
+}
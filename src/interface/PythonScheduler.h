@@ -0,0 +1,98 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_PYTHONSCHEDULER_H
+#define ELASTISIM_PYTHONSCHEDULER_H
+
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "Scheduler.h"
+#include "Profiler.h"
+
+class Job;
+
+struct SchedulingDecision;
+
+// Hosts a Python scheduling algorithm within the simulator process, selected by a zmq_url of the form
+// python://<module or file>. The module's schedule(jobs, nodes, system) function is called on every invocation
+// with views onto the simulator's jobs and nodes, which read their attributes on access instead of serializing them.
+// Decisions are taken by calling assign, assign_num_gpus_per_node, kill or set_runtime_argument on job views.
+class PythonScheduler {
+
+private:
+	static PyObject* function;
+	static PyObject* jobViewType;
+	static PyObject* nodeViewType;
+	static PyObject* nodeViews;
+	static std::map<int, PyObject*> jobViews;
+	static std::vector<PyObject*> decidedJobs;
+	static PyThreadState* threadState;
+	static bool forwardIoInformation;
+
+	static PyModuleDef moduleDefinition;
+	static PyGetSetDef jobViewAttributes[];
+	static PyMethodDef jobViewMethods[];
+	static PyType_Slot jobViewSlots[];
+	static PyType_Spec jobViewSpec;
+	static PyGetSetDef nodeViewAttributes[];
+	static PyType_Slot nodeViewSlots[];
+	static PyType_Spec nodeViewSpec;
+
+	static PyObject* createModule();
+
+	static PyObject* getJobView(Job* job);
+
+	[[nodiscard]] static Job* getJob(PyObject* self);
+
+	[[nodiscard]] static SchedulingDecision* getDecision(PyObject* self);
+
+	static PyObject* getJobAttribute(PyObject* self, void* attribute);
+
+	static PyObject* assignNodes(PyObject* self, PyObject* nodes);
+
+	static PyObject* assignNumGpusPerNode(PyObject* self, PyObject* numGpusPerNode);
+
+	static PyObject* killJob(PyObject* self, PyObject* unused);
+
+	static PyObject* suspendJob(PyObject* self, PyObject* arguments, PyObject* keywords);
+
+	static PyObject* resumeJob(PyObject* self, PyObject* unused);
+
+	static PyObject* setRuntimeArgument(PyObject* self, PyObject* arguments);
+
+	static PyObject* estimateRuntime(PyObject* self, PyObject* arguments);
+
+	static PyObject* representJob(PyObject* self);
+
+	static void deallocateJobView(PyObject* self);
+
+	static PyObject* getNodeAttribute(PyObject* self, void* attribute);
+
+	static PyObject* representNode(PyObject* self);
+
+	static void deallocateNodeView(PyObject* self);
+
+public:
+	static void init(const std::string& module);
+
+	[[nodiscard]] static std::vector<Job*>
+	schedule(InvocationType invocationType, const std::vector<Job*>& jobQueue, const std::vector<Job*>& modifiedJobs,
+			 const Job* requestingJob, int numberOfNodes, SchedulingTiming& timing);
+
+	static void finalize();
+
+};
+
+
+#endif //ELASTISIM_PYTHONSCHEDULER_H
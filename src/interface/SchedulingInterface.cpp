@@ -9,19 +9,112 @@
  */
 
 #include "SchedulingInterface.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include "Job.h"
 #include "Node.h"
 #include "PlatformManager.h"
+#include "NodeAllocator.h"
 #include "Configuration.h"
+#include "Utility.h"
+#include "Profiler.h"
+#ifdef ELASTISIM_EMBEDDED_PYTHON
+#include "PythonScheduler.h"
+#endif
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(SchedulingInterface, "Messages within the scheduling interface");
 
 zmq::context_t SchedulingInterface::context;
 zmq::socket_t SchedulingInterface::socket(context, zmq::socket_type::pair);
+SharedMemoryChannel SchedulingInterface::channel;
+bool SchedulingInterface::sharedMemory = false;
+bool SchedulingInterface::embeddedPython = false;
 const bool SchedulingInterface::forwardIoInformation = Configuration::getBoolIfExists("forward_io_information");
+std::ofstream SchedulingInterface::recordLog;
+std::ifstream SchedulingInterface::replayLog;
+size_t SchedulingInterface::invocationCounter = 0;
+
+void SchedulingInterface::send(const std::string& message) {
+	if (sharedMemory) {
+		channel.send(message);
+	} else {
+		socket.send(zmq::buffer(message));
+	}
+}
 
-void SchedulingInterface::invokeScheduling(InvocationType invocationType, const std::vector<Job*>& modifiedJobs,
-										   const Job* requestingJob, int numberOfNodes) {
+std::string SchedulingInterface::receive() {
+	if (sharedMemory) {
+		return channel.receive();
+	}
+	zmq::message_t message;
+	std::optional<size_t> result = socket.recv(message, zmq::recv_flags::none);
+	if (!result) {
+		xbt_die("ZeroMQ communication failed");
+	}
+	return message.to_string();
+}
+
+std::string SchedulingInterface::hash(const std::string& message) {
+	std::stringstream stream;
+	stream << std::hex << std::setw(16) << std::setfill('0') << Utility::hash(message);
+	return stream.str();
+}
+
+void SchedulingInterface::recordDecision(InvocationType invocationType, const std::string& request,
+										 const nlohmann::json& reply) {
+	nlohmann::json record;
+	record["invocation"] = invocationCounter;
+	record["invocation_type"] = invocationType;
+	record["time"] = simgrid::s4u::Engine::get_clock();
+	record["hash"] = hash(request);
+	record["reply"] = reply;
+	recordLog << record.dump() << std::endl;
+}
+
+nlohmann::json SchedulingInterface::replayDecision(InvocationType invocationType, const std::string& request) {
+	std::string line;
+	if (!std::getline(replayLog, line)) {
+		xbt_die("Recorded scheduling decisions exhausted after %zu invocations", invocationCounter);
+	}
+	nlohmann::json record = nlohmann::json::parse(line);
+	if (record["hash"] != hash(request)) {
+		int recordedInvocationType = record["invocation_type"];
+		double recordedTime = record["time"];
+		xbt_die("Scheduling invocation %zu diverged from the recording: recorded invocation type %d at time %f, "
+				"but got invocation type %d at time %f", invocationCounter, recordedInvocationType, recordedTime,
+				invocationType, simgrid::s4u::Engine::get_clock());
+	}
+	return record["reply"];
+}
+
+std::string SchedulingInterface::handleEstimates(const nlohmann::json& queries, const std::vector<Job*>& jobQueue) {
+	nlohmann::json message;
+	message["code"] = ZMQ_ESTIMATED;
+	message["estimates"] = nlohmann::json::array();
+	for (const auto& query: queries) {
+		int jobId = query["id"];
+		if (jobId < 0 || jobId >= (int) jobQueue.size()) {
+			xbt_die("Job %d does not exist and can not be estimated", jobId);
+		}
+		Job* job = jobQueue[jobId];
+		if (!job) {
+			xbt_die("Job %d has already finished and can not be estimated", jobId);
+		}
+		int numNodes = query["num_nodes"];
+		int numGpusPerNode = query.value("num_gpus_per_node", 0);
+		// infeasible configurations are estimated as infinite and serialized as null
+		message["estimates"].push_back({{"id", job->getId()}, {"num_nodes", numNodes},
+										{"num_gpus_per_node", numGpusPerNode},
+										{"runtime", job->estimateRuntime(numNodes, numGpusPerNode)}});
+	}
+	return message.dump();
+}
+
+std::string SchedulingInterface::invokeScheduling(InvocationType invocationType, const std::vector<Job*>& modifiedJobs,
+										   const Job* requestingJob, int numberOfNodes, SchedulingTiming& timing) {
+	auto start = Profiler::now();
 	const std::vector<Node*>& nodes = PlatformManager::getModifiedComputeNodes();
 	nlohmann::json message;
 	message["code"] = ZMQ_INVOKE_SCHEDULING;
@@ -37,9 +130,20 @@ void SchedulingInterface::invokeScheduling(InvocationType invocationType, const
 	for (const auto& job: modifiedJobs) {
 		message["jobs"].push_back(job->toJson());
 	}
-	message["nodes"] = nlohmann::json::array();
-	for (const auto& node: nodes) {
-		message["nodes"].push_back(node->toJson());
+	if (NodeAllocator::isEnabled()) {
+		// per-class counts keep the message size independent of the number of nodes
+		for (const auto& job: modifiedJobs) {
+			NodeAllocator::reconcile(job);
+		}
+		for (const auto& node: nodes) {
+			NodeAllocator::updateNodeState(node);
+		}
+		message["node_classes"] = NodeAllocator::toJson();
+	} else {
+		message["nodes"] = nlohmann::json::array();
+		for (const auto& node: nodes) {
+			message["nodes"].push_back(node->toJson());
+		}
 	}
 	if (forwardIoInformation) {
 		message["pfs_read_bw"] = PlatformManager::getPfsReadBandwidth();
@@ -49,12 +153,93 @@ void SchedulingInterface::invokeScheduling(InvocationType invocationType, const
 	}
 	PlatformManager::clearModifiedJobs();
 	PlatformManager::clearModifiedComputeNodes();
-	socket.send(zmq::buffer(message.dump()));
+	timing.durations[STAGE_BUILD] = Profiler::elapsed(start);
+	start = Profiler::now();
+	std::string serializedMessage = message.dump();
+	timing.durations[STAGE_DUMP] = Profiler::elapsed(start);
+	timing.requestSize = serializedMessage.size();
+	if (!replayLog.is_open()) {
+		start = Profiler::now();
+		send(serializedMessage);
+		timing.durations[STAGE_SEND] = Profiler::elapsed(start);
+	}
+	return serializedMessage;
 }
 
 void SchedulingInterface::init() {
-	socket = zmq::socket_t(context, zmq::socket_type::pair);
-	socket.bind(Configuration::get("zmq_url"));
+	NodeAllocator::init();
+	if (Configuration::exists("zmq_url") && ((std::string) Configuration::get("zmq_url")).rfind("python://", 0) == 0) {
+#ifdef ELASTISIM_EMBEDDED_PYTHON
+		if (Configuration::exists("scheduling_record") || Configuration::exists("scheduling_replay")) {
+			xbt_die("Scheduling decisions of embedded Python scheduling algorithms can not be recorded or replayed");
+		}
+		if (NodeAllocator::isEnabled()) {
+			// Python algorithms assign concrete nodes, which the allocator would never claim or reconcile
+			xbt_die("Embedded Python scheduling algorithms do not support count-based allocation");
+		}
+		PythonScheduler::init(((std::string) Configuration::get("zmq_url")).substr(9));
+		embeddedPython = true;
+		return;
+#else
+		xbt_die("Embedded Python scheduling algorithms require building with ELASTISIM_EMBEDDED_PYTHON");
+#endif
+	}
+	if (Configuration::exists("scheduling_record") && Configuration::exists("scheduling_replay")) {
+		xbt_die("Scheduling decisions can not be recorded and replayed at the same time");
+	}
+	if (Configuration::exists("scheduling_replay")) {
+		std::string replayFile = Configuration::get("scheduling_replay");
+		replayLog = std::ifstream(replayFile);
+		if (!replayLog.is_open()) {
+			xbt_die("Could not open recorded scheduling decisions %s", replayFile.c_str());
+		}
+		XBT_INFO("Replaying scheduling decisions from %s", replayFile.c_str());
+		return;
+	}
+	if (Configuration::exists("scheduling_record")) {
+		recordLog = std::ofstream(Configuration::get("scheduling_record"));
+	}
+	std::string url = Configuration::get("zmq_url");
+	if (SharedMemoryChannel::isSharedMemoryUrl(url)) {
+		uint64_t capacity = 16 << 20;
+		if (Configuration::exists("shm_capacity")) {
+			capacity = Configuration::get("shm_capacity");
+		}
+		try {
+			channel.create(url, capacity);
+		} catch (const std::runtime_error& error) {
+			xbt_die("%s", error.what());
+		}
+		sharedMemory = true;
+	} else {
+		socket = zmq::socket_t(context, zmq::socket_type::pair);
+		socket.bind(url);
+	}
+}
+
+void SchedulingInterface::applyDecision(Job* job, const SchedulingDecision& decision) {
+	if (decision.kill) {
+		job->setState(PENDING_KILL);
+	} else if (decision.suspend) {
+		job->suspend(decision.retainNodes);
+	} else {
+		job->assignNodes(decision.assignedNodes);
+		if (job->getType() != RIGID) {
+			job->assignNumGpusPerNode(decision.assignedNumGpusPerNode);
+		}
+		if (decision.modifiedRuntimeArguments) {
+			job->clearRuntimeArguments();
+			for (const auto& [key, value]: decision.runtimeArguments) {
+				job->updateRuntimeArguments(key, value);
+			}
+		}
+		job->checkConfigurationValidity();
+		if (decision.resume) {
+			job->resume();
+		} else {
+			job->updateState();
+		}
+	}
 }
 
 std::vector<Job*>
@@ -63,24 +248,39 @@ SchedulingInterface::handleSchedule(const nlohmann::json& jsonJobs, const std::v
 	std::vector<Job*> scheduledJobs;
 	for (const auto& jsonJob: jsonJobs) {
 		Job* job = jobQueue[jsonJob["id"]];
-		if (jsonJob["kill_flag"]) {
-			job->setState(PENDING_KILL);
-		} else {
-			job->clearAssignedNodes();
-			for (const auto& jsonNodeId: jsonJob["assigned_node_ids"]) {
-				job->assignNode(nodes[jsonNodeId]);
+		if (!job) {
+			int jobId = jsonJob["id"];
+			xbt_die("Job %d has already finished and can not be scheduled", jobId);
+		}
+		SchedulingDecision decision;
+		decision.kill = jsonJob["kill_flag"];
+		decision.suspend = jsonJob.value("suspend_flag", false);
+		if (decision.suspend) {
+			decision.retainNodes = jsonJob.value("retain_nodes", false);
+		}
+		decision.resume = jsonJob.value("resume_flag", false);
+		if (!decision.kill && !decision.suspend) {
+			if (jsonJob.contains("assigned_node_counts")) {
+				decision.assignedNodes = NodeAllocator::allocate(job, jsonJob["assigned_node_counts"]);
+			} else {
+				decision.assignedNodes = Utility::expandNodeIds(jsonJob["assigned_node_ids"], nodes);
+				if (NodeAllocator::isEnabled()) {
+					NodeAllocator::claim(job, decision.assignedNodes);
+				}
 			}
 			if (job->getType() != RIGID) {
-				job->assignNumGpusPerNode(jsonJob["assigned_num_gpus_per_node"]);
+				decision.assignedNumGpusPerNode = jsonJob["assigned_num_gpus_per_node"];
 			}
-			if (jsonJob["modified_runtime_args"]) {
-				job->clearRuntimeArguments();
+			decision.modifiedRuntimeArguments = jsonJob["modified_runtime_args"];
+			if (decision.modifiedRuntimeArguments) {
 				for (const auto& mapping: jsonJob["runtime_arguments"].items()) {
-					job->updateRuntimeArguments(mapping.key(), mapping.value());
+					decision.runtimeArguments[mapping.key()] = mapping.value();
 				}
 			}
-			job->checkConfigurationValidity();
-			job->updateState();
+		}
+		applyDecision(job, decision);
+		if (NodeAllocator::isEnabled()) {
+			NodeAllocator::reconcile(job);
 		}
 		scheduledJobs.push_back(job);
 	}
@@ -91,26 +291,75 @@ std::vector<Job*> SchedulingInterface::schedule(InvocationType invocationType, c
 												const std::vector<Job*>& modifiedJobs, const Job* requestingJob,
 												int numberOfNodes) {
 
-	zmq::message_t message;
 	nlohmann::json json;
+	SchedulingTiming timing{invocationType};
+#ifdef ELASTISIM_EMBEDDED_PYTHON
+	if (embeddedPython) {
+		std::vector<Job*> scheduledJobs = PythonScheduler::schedule(invocationType, jobQueue, modifiedJobs,
+																	requestingJob, numberOfNodes, timing);
+		Profiler::recordScheduling(timing);
+		return scheduledJobs;
+	}
+#endif
 
-	invokeScheduling(invocationType, modifiedJobs, requestingJob, numberOfNodes);
+	std::string request = invokeScheduling(invocationType, modifiedJobs, requestingJob, numberOfNodes, timing);
 
-	std::optional<size_t> result = socket.recv(message, zmq::recv_flags::none);
-	if (!result) {
-		xbt_die("ZeroMQ communication failed");
+	auto start = Profiler::now();
+	if (replayLog.is_open()) {
+		json = replayDecision(invocationType, request);
+		timing.durations[STAGE_WAIT] = Profiler::elapsed(start);
+	} else {
+		std::string reply = receive();
+		timing.durations[STAGE_WAIT] = Profiler::elapsed(start);
+		timing.replySize = reply.size();
+		start = Profiler::now();
+		json = nlohmann::json::parse(reply);
+		timing.durations[STAGE_PARSE] = Profiler::elapsed(start);
+		// the algorithm may query runtime estimates any number of times before it decides
+		while (json["code"] == ZMQ_ESTIMATE) {
+			send(handleEstimates(json["queries"], jobQueue));
+			json = nlohmann::json::parse(receive());
+		}
+	}
+	if (recordLog.is_open()) {
+		recordDecision(invocationType, request, json);
 	}
-	json = nlohmann::json::parse(message.to_string());
+	++invocationCounter;
 	if (json["code"] == ZMQ_SCHEDULED) {
-		return handleSchedule(json["jobs"], jobQueue);
+		start = Profiler::now();
+		std::vector<Job*> scheduledJobs = handleSchedule(json["jobs"], jobQueue);
+		timing.durations[STAGE_APPLY] = Profiler::elapsed(start);
+		Profiler::recordScheduling(timing);
+		return scheduledJobs;
 	} else {
 		xbt_die("Unknown message code from scheduling algorithm");
 	}
 }
 
 void SchedulingInterface::finalize() {
+#ifdef ELASTISIM_EMBEDDED_PYTHON
+	if (embeddedPython) {
+		PythonScheduler::finalize();
+		return;
+	}
+#endif
+	if (replayLog.is_open()) {
+		std::string line;
+		if (std::getline(replayLog, line) && !line.empty()) {
+			XBT_WARN("Simulation finished before all recorded scheduling decisions were replayed");
+		}
+		replayLog.close();
+		return;
+	}
+	if (recordLog.is_open()) {
+		recordLog.close();
+	}
 	nlohmann::json message;
 	message["code"] = ZMQ_FINALIZE;
-	socket.send(zmq::buffer(message.dump()));
-	socket.close();
+	send(message.dump());
+	if (sharedMemory) {
+		channel.close();
+	} else {
+		socket.close();
+	}
 }
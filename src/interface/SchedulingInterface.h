@@ -12,9 +12,12 @@
 #define ELASTISIM_SCHEDULINGINTERFACE_H
 
 
+#include <fstream>
 #include <zmq.hpp>
 #include <json.hpp>
 #include "Scheduler.h"
+#include "Profiler.h"
+#include "SharedMemoryChannel.h"
 
 class Job;
 
@@ -23,23 +26,57 @@ class Node;
 enum CommunicationCode {
 	ZMQ_INVOKE_SCHEDULING = 0xFFEC4400,
 	ZMQ_SCHEDULED = 0xFFEC4401,
+	ZMQ_ESTIMATE = 0xFFEC4402,
+	ZMQ_ESTIMATED = 0xFFEC4403,
 	ZMQ_FINALIZE = 0xFFEC44FF
 };
 
+// outcome of a scheduling invocation for a single job, independent of how the scheduling algorithm is attached
+struct SchedulingDecision {
+	bool kill = false;
+	bool suspend = false;
+	bool retainNodes = false;
+	bool resume = false;
+	std::vector<Node*> assignedNodes;
+	int assignedNumGpusPerNode = 0;
+	bool modifiedRuntimeArguments = false;
+	std::map<std::string, std::string> runtimeArguments;
+};
+
 class SchedulingInterface {
 
 private:
 	static zmq::context_t context;
 	static zmq::socket_t socket;
+	static SharedMemoryChannel channel;
+	static bool sharedMemory;
+	static bool embeddedPython;
 	static const bool forwardIoInformation;
+	static std::ofstream recordLog;
+	static std::ifstream replayLog;
+	static size_t invocationCounter;
+
+	static void send(const std::string& message);
+
+	[[nodiscard]] static std::string receive();
+
+	[[nodiscard]] static std::string hash(const std::string& message);
 
-	static void
+	static void recordDecision(InvocationType invocationType, const std::string& request, const nlohmann::json& reply);
+
+	[[nodiscard]] static nlohmann::json replayDecision(InvocationType invocationType, const std::string& request);
+
+	[[nodiscard]] static std::string handleEstimates(const nlohmann::json& queries, const std::vector<Job*>& jobQueue);
+
+	static std::string
 	invokeScheduling(InvocationType invocationType, const std::vector<Job*>& modifiedJobs, const Job* requestingJob,
-					 int numberOfNodes);
+					 int numberOfNodes, SchedulingTiming& timing);
 
 public:
 	static void init();
 
+	static void applyDecision(Job* job, const SchedulingDecision& decision);
+
 	[[nodiscard]] static std::vector<Job*>
 	handleSchedule(const nlohmann::json& jsonJobs, const std::vector<Job*>& jobQueue);
 
@@ -0,0 +1,257 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_SHAREDMEMORYCHANNEL_H
+#define ELASTISIM_SHAREDMEMORYCHANNEL_H
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Message channel between ElastiSim and a scheduler on the same machine, selected by a zmq_url of the form
+// shm://<name>. The simulator creates the POSIX shared-memory segment /<name>, the scheduler attaches to it.
+// This header does not depend on the rest of ElastiSim and serves as the reference client for C++ schedulers;
+// client/elastisim_shm.py implements the same protocol for Python schedulers.
+//
+// The segment holds one byte ring per direction. Every message is framed by its length as a 64-bit integer and is
+// streamed through the ring, so messages may exceed the ring capacity. Each counter is only ever written by one
+// side. A waiting side spins briefly and then sleeps on the 32-bit signal word of the counter it waits for, which
+// the other side increments after every update. The waiters counters let the notifying side skip the wake syscall;
+// a client that can not update them atomically sets its counters to one once and is then woken on every update.
+// Layout (little-endian, byte offsets):
+//
+//   0      uint32 magic, uint32 version, uint64 capacity of each ring
+//   64     ring 0, simulator to scheduler:
+//            +0 uint64 head, +8 uint32 head signal, +12 uint32 head waiters
+//            +64 uint64 tail, +72 uint32 tail signal, +76 uint32 tail waiters
+//   192    ring 1, scheduler to simulator, same layout
+//   4096   data of ring 0, followed by the data of ring 1
+
+struct SharedMemoryRing {
+	alignas(64) std::atomic<uint64_t> head;
+	std::atomic<uint32_t> headSignal;
+	std::atomic<uint32_t> headWaiters;
+	alignas(64) std::atomic<uint64_t> tail;
+	std::atomic<uint32_t> tailSignal;
+	std::atomic<uint32_t> tailWaiters;
+};
+
+struct SharedMemorySegment {
+	std::atomic<uint32_t> magic;
+	uint32_t version;
+	uint64_t capacity;
+	SharedMemoryRing rings[2];
+};
+
+static_assert(sizeof(SharedMemoryRing) == 128 && sizeof(SharedMemorySegment) == 320,
+			  "Unexpected shared memory layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+			  "Shared memory counters must be lock-free");
+
+class SharedMemoryChannel {
+
+private:
+	static const uint32_t MAGIC = 0x454C5348;
+	static const uint32_t VERSION = 1;
+	static const size_t DATA_OFFSET = 4096;
+	static const int SPIN_ITERATIONS = 2048;
+
+	std::string name;
+	SharedMemorySegment* segment = nullptr;
+	char* data = nullptr;
+	size_t mappingSize = 0;
+	uint64_t capacity = 0;
+	bool owner = false;
+	int sendRing = 0;
+	int receiveRing = 1;
+
+	static void wait(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters, uint32_t value) {
+		for (int i = 0; i < SPIN_ITERATIONS; ++i) {
+			if (signal.load(std::memory_order_acquire) != value) {
+				return;
+			}
+			std::this_thread::yield();
+		}
+		waiters.fetch_add(1);
+		while (signal.load() == value) {
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAIT, value, nullptr, nullptr, 0);
+		}
+		waiters.fetch_sub(1);
+	}
+
+	static void notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters) {
+		signal.fetch_add(1);
+		if (waiters.load() > 0) {
+			syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+		}
+	}
+
+	void write(const char* bytes, size_t size) {
+		SharedMemoryRing& ring = segment->rings[sendRing];
+		char* buffer = data + sendRing * capacity;
+		uint64_t head = ring.head.load(std::memory_order_relaxed);
+		while (size > 0) {
+			uint32_t signal = ring.tailSignal.load(std::memory_order_acquire);
+			uint64_t free = capacity - (head - ring.tail.load(std::memory_order_acquire));
+			if (free == 0) {
+				wait(ring.tailSignal, ring.tailWaiters, signal);
+				continue;
+			}
+			uint64_t offset = head % capacity;
+			size_t chunk = std::min<uint64_t>({size, free, capacity - offset});
+			std::memcpy(buffer + offset, bytes, chunk);
+			head += chunk;
+			bytes += chunk;
+			size -= chunk;
+			ring.head.store(head, std::memory_order_release);
+			notify(ring.headSignal, ring.headWaiters);
+		}
+	}
+
+	void read(char* bytes, size_t size) {
+		SharedMemoryRing& ring = segment->rings[receiveRing];
+		const char* buffer = data + receiveRing * capacity;
+		uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+		while (size > 0) {
+			uint32_t signal = ring.headSignal.load(std::memory_order_acquire);
+			uint64_t available = ring.head.load(std::memory_order_acquire) - tail;
+			if (available == 0) {
+				wait(ring.headSignal, ring.headWaiters, signal);
+				continue;
+			}
+			uint64_t offset = tail % capacity;
+			size_t chunk = std::min<uint64_t>({size, available, capacity - offset});
+			std::memcpy(bytes, buffer + offset, chunk);
+			tail += chunk;
+			bytes += chunk;
+			size -= chunk;
+			ring.tail.store(tail, std::memory_order_release);
+			notify(ring.tailSignal, ring.tailWaiters);
+		}
+	}
+
+	void map(int fd, size_t size) {
+		void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (address == MAP_FAILED) {
+			throw std::runtime_error("Could not map shared memory segment " + name + ": " + std::strerror(errno));
+		}
+		mappingSize = size;
+		segment = static_cast<SharedMemorySegment*>(address);
+		data = static_cast<char*>(address) + DATA_OFFSET;
+	}
+
+public:
+	[[nodiscard]] static bool isSharedMemoryUrl(const std::string& url) {
+		return url.rfind("shm://", 0) == 0;
+	}
+
+	SharedMemoryChannel() = default;
+
+	SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+
+	SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+	~SharedMemoryChannel() {
+		close();
+	}
+
+	// called by the simulator, replaces a stale segment left behind by a previous run
+	void create(const std::string& url, uint64_t ringCapacity) {
+		name = "/" + url.substr(6);
+		shm_unlink(name.c_str());
+		int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (fd < 0) {
+			throw std::runtime_error("Could not create shared memory segment " + name + ": " + std::strerror(errno));
+		}
+		if (ftruncate(fd, (off_t) (DATA_OFFSET + 2 * ringCapacity)) != 0) {
+			::close(fd);
+			throw std::runtime_error("Could not resize shared memory segment " + name + ": " + std::strerror(errno));
+		}
+		map(fd, DATA_OFFSET + 2 * ringCapacity);
+		owner = true;
+		sendRing = 0;
+		receiveRing = 1;
+		capacity = ringCapacity;
+		segment->version = VERSION;
+		segment->capacity = ringCapacity;
+		segment->magic.store(MAGIC, std::memory_order_release);
+	}
+
+	// called by the scheduler, waits until the simulator has created the segment
+	void attach(const std::string& url) {
+		name = "/" + url.substr(6);
+		while (true) {
+			int fd = shm_open(name.c_str(), O_RDWR, 0600);
+			struct stat status{};
+			if (fd >= 0 && fstat(fd, &status) == 0 && (size_t) status.st_size > DATA_OFFSET) {
+				map(fd, status.st_size);
+				break;
+			}
+			if (fd >= 0) {
+				::close(fd);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		while (segment->magic.load(std::memory_order_acquire) != MAGIC) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		if (segment->version != VERSION) {
+			throw std::runtime_error("Unsupported shared memory protocol version " + std::to_string(segment->version));
+		}
+		owner = false;
+		sendRing = 1;
+		receiveRing = 0;
+		capacity = segment->capacity;
+	}
+
+	void send(const std::string& message) {
+		uint64_t size = message.size();
+		write(reinterpret_cast<const char*>(&size), sizeof(size));
+		write(message.data(), message.size());
+	}
+
+	[[nodiscard]] std::string receive() {
+		uint64_t size;
+		read(reinterpret_cast<char*>(&size), sizeof(size));
+		std::string message(size, '\0');
+		read(message.data(), size);
+		return message;
+	}
+
+	void close() {
+		if (segment) {
+			munmap(segment, mappingSize);
+			segment = nullptr;
+			data = nullptr;
+			if (owner) {
+				shm_unlink(name.c_str());
+			}
+		}
+	}
+
+};
+
+
+#endif //ELASTISIM_SHAREDMEMORYCHANNEL_H
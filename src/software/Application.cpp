@@ -18,6 +18,8 @@
 #include "SchedMsg.h"
 #include "Utility.h"
 #include "Configuration.h"
+#include "Profiler.h"
+#include "Communication.h"
 
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(Application, "Messages within the application");
@@ -31,6 +33,100 @@ void Application::waitForAsyncActivities(const std::vector<simgrid::s4u::Activit
 	}
 }
 
+void Application::executeTaskGraph(const Phase* phase, const Node* node, const Job* job,
+								   const std::vector<Node*>& nodes, int rank,
+								   const simgrid::s4u::BarrierPtr& barrier) {
+	const std::deque<const Task*>& tasks = phase->getTasks();
+	const std::vector<std::vector<size_t>>& dependencies = phase->getDependencies();
+	size_t numTasks = tasks.size();
+	std::vector<size_t> missingDependencies(numTasks);
+	std::vector<std::vector<size_t>> dependents(numTasks);
+	for (size_t i = 0; i < numTasks; ++i) {
+		missingDependencies[i] = dependencies[i].size();
+		for (size_t dependency: dependencies[i]) {
+			dependents[dependency].push_back(i);
+		}
+	}
+	std::vector<bool> started(numTasks, false);
+	std::vector<int> issuedIterations(numTasks, 0);
+	std::vector<size_t> pendingActivities(numTasks, 0);
+	std::vector<double> taskStarts(numTasks);
+	std::vector<simgrid::s4u::ActivityPtr> activities;
+	std::vector<size_t> owners;
+	size_t finishedTasks = 0;
+
+	const auto& finish = [&](size_t index) {
+		double taskEnd = Utility::logTaskEnd(tasks[index], taskStarts[index]);
+		if (logTaskTimes) {
+			node->logTaskTime(job, tasks[index], taskEnd);
+		}
+		for (size_t dependent: dependents[index]) {
+			--missingDependencies[dependent];
+		}
+		++finishedTasks;
+	};
+	// issues iterations of a concurrent task until one of them leaves activities to wait for
+	const auto& advance = [&](size_t index) {
+		const Task* task = tasks[index];
+		while (issuedIterations[index] < task->getIterations()) {
+			std::vector<simgrid::s4u::ActivityPtr> issued = task->executeAsync(node, job, nodes, rank);
+			++issuedIterations[index];
+			if (!issued.empty()) {
+				pendingActivities[index] = issued.size();
+				activities.insert(std::end(activities), std::begin(issued), std::end(issued));
+				owners.insert(std::end(owners), issued.size(), index);
+				return;
+			}
+		}
+		finish(index);
+	};
+
+	while (finishedTasks < numTasks) {
+		// blocking tasks run in the listed order on every rank, so their barriers line up across the ranks
+		bool blockingTaskWaiting = false;
+		bool startedTask = false;
+		for (size_t i = 0; i < numTasks; ++i) {
+			if (started[i]) {
+				continue;
+			}
+			const Task* task = tasks[i];
+			bool concurrent = task->canExecuteAsync() && !task->isSynchronized();
+			if (missingDependencies[i] > 0 || (!concurrent && blockingTaskWaiting)) {
+				blockingTaskWaiting = blockingTaskWaiting || !concurrent;
+				continue;
+			}
+			started[i] = true;
+			startedTask = true;
+			int iterations = task->getIterations();
+			taskStarts[i] = Utility::logTaskStart(task, iterations);
+			if (concurrent) {
+				advance(i);
+			} else {
+				for (int j = 0; j < iterations; ++j) {
+					double iterationStart = Utility::logIterationStart(iterations, j);
+					if (task->isSynchronized()) {
+						Profiler::count(COUNT_BARRIER_WAITS);
+						barrier->wait();
+					}
+					task->execute(node, job, nodes, rank, barrier);
+					Utility::logIterationEnd(iterations, j, iterationStart);
+				}
+				finish(i);
+			}
+		}
+		if (startedTask || finishedTasks == numTasks) {
+			continue;
+		}
+		ssize_t completed = simgrid::s4u::Activity::wait_any(activities);
+		size_t owner = owners[completed];
+		activities.erase(std::begin(activities) + completed);
+		owners.erase(std::begin(owners) + completed);
+		if (--pendingActivities[owner] == 0) {
+			advance(owner);
+		}
+	}
+}
+
 void
 Application::executeOneTimePhase(const Phase* phase, const Node* node, const Job* job, const std::vector<Node*>& nodes,
 								 int rank, const simgrid::s4u::BarrierPtr& barrier) {
@@ -40,17 +136,25 @@ Application::executeOneTimePhase(const Phase* phase, const Node* node, const Job
 	}
 	std::vector<simgrid::s4u::ActivityPtr> asyncActivities;
 	for (int i = 0; i < phase->getIterations(); ++i) {
+		if (phase->hasDependencies()) {
+			executeTaskGraph(phase, node, job, nodes, rank, barrier);
+			continue;
+		}
 		for (const auto& task: phase->getTasks()) {
 			int iterations = task->getIterations();
 			double taskStart = Utility::logTaskStart(task, iterations);
 			for (int j = 0; j < iterations; ++j) {
 				double iterationStart = Utility::logIterationStart(iterations, j);
 				if (task->isSynchronized()) {
+					Profiler::count(COUNT_BARRIER_WAITS);
 					barrier->wait();
 				}
 				if (task->isAsynchronous()) {
 					std::vector<simgrid::s4u::ActivityPtr> activities = task->executeAsync(node, job, nodes, rank);
 					asyncActivities.insert(std::end(asyncActivities), std::begin(activities), std::end(activities));
+				} else if (task->waitsForAsyncActivities()) {
+					waitForAsyncActivities(asyncActivities);
+					asyncActivities.clear();
 				} else {
 					task->execute(node, job, nodes, rank, barrier);
 				}
@@ -81,8 +185,36 @@ void Application::operator()() {
 		node->markReconfigured(job);
 	}
 
-	const simgrid::s4u::BarrierPtr& barrier = node->getBarrier(job);
+	// evaluated before the barrier, after which rank 0 leaves the reconfiguration state
+	bool reconfiguring = job->getState() == IN_RECONFIGURATION;
+	bool redistributing = reconfiguring && job->getRedistributionBytes() > 0;
+	bool restarting = node->isRestarting(job);
+	// copied, since the node may release the job while this rank is still waiting
+	simgrid::s4u::BarrierPtr barrier = node->getBarrier(job);
+	Profiler::count(COUNT_BARRIER_WAITS);
 	barrier->wait();
+	if (restarting) {
+		if (job->getCheckpointOverhead() > 0) {
+			// writing the checkpoint on suspension and reading it back on restart
+			XBT_INFO("Checkpoint overhead of %f seconds", job->getCheckpointOverhead());
+			simgrid::s4u::this_actor::sleep_for(job->getCheckpointOverhead());
+		}
+		node->markRestarted(job);
+	}
+	if (reconfiguring && job->getReconfigurationOverhead() > 0) {
+		// process management of the runtime: spawning new processes and rebuilding the communicator
+		XBT_INFO("Reconfiguration overhead of %f seconds", job->getReconfigurationOverhead());
+		simgrid::s4u::this_actor::sleep_for(job->getReconfigurationOverhead());
+	}
+	if (redistributing) {
+		XBT_INFO("Redistributing %f bytes of state from %zu to %zu nodes", job->getRedistributionBytes(),
+				 job->getRedistributionSources().size(), job->getExecutingNodes().size());
+		waitForAsyncActivities(node->trackActivities(
+				job, Communication::redistribute(job->getRedistributionSources(), job->getExecutingNodes(), rank,
+												 job->getRedistributionBytes(), job)));
+		Profiler::count(COUNT_BARRIER_WAITS);
+		barrier->wait();
+	}
 	if (rank == 0) {
 		job->setState(RUNNING);
 	}
@@ -111,9 +243,13 @@ void Application::operator()() {
 				if (numberOfNodes != job->getNumberOfExecutingNodes()) {
 					waitForAsyncActivities(asyncActivities);
 					asyncActivities.clear();
+					Profiler::count(COUNT_BARRIER_WAITS);
 					barrier->wait();
 					if (rank == 0) {
 						job->advanceWorkload(completedPhases, remainingIterations);
+						for (const auto& executingNode: job->getExecutingNodes()) {
+							executingNode->markExited(job);
+						}
 						s4u_Mailbox* mailboxScheduler = s4u_Mailbox::by_name("Scheduler");
 						mailboxScheduler->put_init(new SchedMsg(EVOLVING_REQUEST, job, numberOfNodes), 0)->detach();
 					}
@@ -122,9 +258,13 @@ void Application::operator()() {
 			} else if ((job->getType() == MALLEABLE || job->getType() == ADAPTIVE) && phase->hasSchedulingPoint()) {
 				waitForAsyncActivities(asyncActivities);
 				asyncActivities.clear();
+				Profiler::count(COUNT_BARRIER_WAITS);
 				barrier->wait();
 				if (rank == 0) {
 					job->advanceWorkload(completedPhases, remainingIterations);
+					for (const auto& executingNode: job->getExecutingNodes()) {
+						executingNode->markExited(job);
+					}
 					s4u_Mailbox* mailboxScheduler = s4u_Mailbox::by_name("Scheduler");
 					mailboxScheduler->put_init(new SchedMsg(SCHEDULING_POINT, job), 0)->detach();
 				}
@@ -135,10 +275,15 @@ void Application::operator()() {
 		if (phase->hasBarrier()) {
 			waitForAsyncActivities(asyncActivities);
 			asyncActivities.clear();
+			Profiler::count(COUNT_BARRIER_WAITS);
 			barrier->wait();
 		}
 
 		std::deque<const Task*> taskQueue = phase->getTasks();
+		if (phase->hasDependencies()) {
+			executeTaskGraph(phase, node, job, job->getExecutingNodes(), rank, barrier);
+			taskQueue.clear();
+		}
 		while (!taskQueue.empty()) {
 			const Task* task = taskQueue.front();
 			int iterations = task->getIterations();
@@ -146,12 +291,16 @@ void Application::operator()() {
 			for (int i = 0; i < iterations; ++i) {
 				double iterationStart = Utility::logIterationStart(iterations, i);
 				if (task->isSynchronized()) {
+					Profiler::count(COUNT_BARRIER_WAITS);
 					barrier->wait();
 				}
 				if (task->isAsynchronous()) {
 					std::vector<simgrid::s4u::ActivityPtr> activities =
 							task->executeAsync(node, job, job->getExecutingNodes(), rank);
 					asyncActivities.insert(std::end(asyncActivities), std::begin(activities), std::end(activities));
+				} else if (task->waitsForAsyncActivities()) {
+					waitForAsyncActivities(asyncActivities);
+					asyncActivities.clear();
 				} else {
 					task->execute(node, job, job->getExecutingNodes(), rank, barrier);
 				}
@@ -171,6 +320,7 @@ void Application::operator()() {
 			if (phaseQueue.empty()) {
 				waitForAsyncActivities(asyncActivities);
 				asyncActivities.clear();
+				Profiler::count(COUNT_BARRIER_WAITS);
 				barrier->wait();
 				if (rank == 0) {
 					s4u_Mailbox* mailboxScheduler = s4u_Mailbox::by_name("Scheduler");
@@ -182,6 +332,10 @@ void Application::operator()() {
 				remainingIterations = phase->getIterations();
 			}
 		}
+		if (remainingIterations > 0) {
+			// iteration boundary a suspended job restarts from when releasing its nodes
+			node->recordProgress(job, completedPhases, remainingIterations);
+		}
 	}
 
 }
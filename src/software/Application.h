@@ -37,6 +37,9 @@ private:
 	executeOneTimePhase(const Phase* phase, const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 						const simgrid::s4u::BarrierPtr& barrier);
 
+	void executeTaskGraph(const Phase* phase, const Node* node, const Job* job, const std::vector<Node*>& nodes,
+						  int rank, const simgrid::s4u::BarrierPtr& barrier);
+
 public:
 	Application(Node* node, Job* job, int rank, bool logTaskTimes);
 
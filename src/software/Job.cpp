@@ -11,6 +11,9 @@
 
 #include "Job.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include "Workload.h"
 #include "Phase.h"
@@ -19,6 +22,7 @@
 #include "Utility.h"
 #include "Configuration.h"
 #include "PlatformManager.h"
+#include "NodeAllocator.h"
 
 Job::Job(int walltime, int numNodes, int numGpusPerNode, double submitTime,
 		 std::map<std::string, std::string> arguments, std::map<std::string, std::string> attributes,
@@ -26,9 +30,12 @@ Job::Job(int walltime, int numNodes, int numGpusPerNode, double submitTime,
 		id(-1), type(RIGID), state(PENDING_SUBMISSION), walltime(walltime), numNodes(numNodes),
 		numGpusPerNode(numGpusPerNode), numNodesMin(-1), numNodesMax(-1), numGpusPerNodeMin(-1), numGpusPerNodeMax(-1),
 		submitTime(submitTime), startTime(-1), endTime(-1), waitTime(-1), makespan(-1), turnaroundTime(-1),
-		workload(std::move(workload)), arguments(std::move(arguments)), attributes(std::move(attributes)),
+		workload(std::move(workload)), totalPhaseCount(-1), completedPhases(-1), arguments(std::move(arguments)), attributes(std::move(attributes)),
 		runtimeArgumentsMutex(s4u_Mutex::create()), assignedNumGpusPerNode(0), executingNumGpusPerNode(0),
-		clipEvolvingRequests(false) {
+		redistributionBytes(0), reconfigurationOverhead(0), totalReconfigurationOverhead(0),
+		numReconfigurations(0), retainingNodes(false), suspensionStart(-1), suspendedTime(0), numSuspensions(0),
+		checkpointOverhead(0), clipEvolvingRequests(false),
+		compressNodeIds(Configuration::getBoolIfExists("compress_node_ids")) {
 	checkSpecification();
 }
 
@@ -39,10 +46,13 @@ Job::Job(int walltime, JobType type, int numNodesMin, int numNodesMax, int numGp
 		numNodes(-1), numGpusPerNode(-1), numNodesMin(numNodesMin), numNodesMax(numNodesMax),
 		numGpusPerNodeMin(numGpusPerNodeMin), numGpusPerNodeMax(numGpusPerNodeMax), submitTime(submitTime),
 		startTime(-1), endTime(-1), waitTime(-1), makespan(-1), turnaroundTime(-1), workload(std::move(workload)),
-		arguments(std::move(arguments)), attributes(std::move(attributes)), runtimeArgumentsMutex(s4u_Mutex::create()),
-		assignedNumGpusPerNode(0), executingNumGpusPerNode(0),
+		totalPhaseCount(-1), completedPhases(-1), arguments(std::move(arguments)), attributes(std::move(attributes)), runtimeArgumentsMutex(s4u_Mutex::create()),
+		assignedNumGpusPerNode(0), executingNumGpusPerNode(0), redistributionBytes(0), reconfigurationOverhead(0),
+		totalReconfigurationOverhead(0), numReconfigurations(0), retainingNodes(false), suspensionStart(-1),
+		suspendedTime(0), numSuspensions(0), checkpointOverhead(0),
 		clipEvolvingRequests(!Configuration::exists("clip_evolving_requests") ||
-							 (bool) Configuration::get("clip_evolving_requests")) {
+							 (bool) Configuration::get("clip_evolving_requests")),
+		compressNodeIds(Configuration::getBoolIfExists("compress_node_ids")) {
 	checkSpecification();
 	additionalArguments["num_nodes_min"] = std::to_string(numNodesMin);
 	additionalArguments["num_nodes_max"] = std::to_string(numNodesMax);
@@ -70,6 +80,8 @@ void Job::setState(JobState newState) {
 			startTime = simgrid::s4u::Engine::get_clock();
 			waitTime = startTime - submitTime;
 			executingNodes = assignedNodes;
+			executingNodeSet = assignedNodeSet;
+			workload->clearEstimates();
 			if (type == RIGID) {
 				executingNumGpusPerNode = numGpusPerNode;
 			} else {
@@ -81,7 +93,20 @@ void Job::setState(JobState newState) {
 		}
 	} else if (state == PENDING_RECONFIGURATION) {
 		if (newState == IN_RECONFIGURATION) {
+			// the state is distributed in blocks over the previous ranks and has to follow the new rank layout
+			redistributionSources = executingNodes;
+			redistributionBytes = 0;
+			if (!workload->getStateModel().empty()) {
+				redistributionBytes = Utility::evaluateFormula(workload->getStateModel(), (int) executingNodes.size(),
+															   executingNumGpusPerNode, runtimeArguments);
+			}
+			reconfigurationOverhead = calculateReconfigurationOverhead(assignedNodes.size(),
+																	   (assignedNodeSet - executingNodeSet).size());
+			totalReconfigurationOverhead += reconfigurationOverhead;
+			++numReconfigurations;
 			executingNodes = assignedNodes;
+			executingNodeSet = assignedNodeSet;
+			workload->clearEstimates();
 			for (const auto& node: assignedNodes) {
 				node->removeExpectedJob(this);
 			}
@@ -90,6 +115,52 @@ void Job::setState(JobState newState) {
 			workload->scaleTo(numNodes, executingNumGpusPerNode, runtimeArguments);
 			workload->scaleReconfigurationPhaseTo(numNodes, executingNumGpusPerNode, runtimeArguments);
 		}
+	} else if (state == PENDING_SUSPENSION) {
+		if (newState == SUSPENDED) {
+			suspensionStart = simgrid::s4u::Engine::get_clock();
+			++numSuspensions;
+			if (!retainingNodes) {
+				// the state is checkpointed by the ranks releasing their nodes and read back on restart
+				double stateBytes = 0;
+				if (!workload->getStateModel().empty()) {
+					stateBytes = Utility::evaluateFormula(workload->getStateModel(), (int) executingNodes.size(),
+														  executingNumGpusPerNode, runtimeArguments);
+				}
+				checkpointOverhead = calculateCheckpointOverhead(stateBytes);
+				assignedNodes.clear();
+				assignedNodeSet = NodeSet();
+				executingNodes.clear();
+				executingNodeSet = NodeSet();
+				workload->clearEstimates();
+			}
+		}
+	} else if (state == PENDING_RESUMPTION) {
+		if (newState == RUNNING) {
+			suspendedTime += simgrid::s4u::Engine::get_clock() - suspensionStart;
+			for (const auto& node: assignedNodes) {
+				node->removeExpectedJob(this);
+			}
+			if (!retainingNodes) {
+				executingNodes = assignedNodes;
+				executingNodeSet = assignedNodeSet;
+				workload->clearEstimates();
+				if (type != RIGID) {
+					size_t numNodes = executingNodes.size();
+					executingNumGpusPerNode = assignedNumGpusPerNode;
+					workload->scaleTo(numNodes, executingNumGpusPerNode, runtimeArguments);
+					workload->scaleInitPhaseTo(numNodes, executingNumGpusPerNode, runtimeArguments);
+				}
+			}
+		}
+	}
+	if (newState == PENDING_SUSPENSION) {
+		// a pending reconfiguration is dropped, the job suspends in its current configuration
+		for (const auto& node: (assignedNodeSet - executingNodeSet).resolve(PlatformManager::getComputeNodes())) {
+			node->removeExpectedJob(this);
+		}
+		assignedNodes = executingNodes;
+		assignedNodeSet = executingNodeSet;
+		assignedNumGpusPerNode = executingNumGpusPerNode;
 	}
 	if (newState == COMPLETED || newState == KILLED) {
 		endTime = simgrid::s4u::Engine::get_clock();
@@ -107,6 +178,30 @@ double Job::getWalltime() const {
 	return walltime;
 }
 
+int Job::getNumNodes() const {
+	return numNodes;
+}
+
+int Job::getNumGpusPerNode() const {
+	return numGpusPerNode;
+}
+
+int Job::getNumNodesMin() const {
+	return numNodesMin;
+}
+
+int Job::getNumNodesMax() const {
+	return numNodesMax;
+}
+
+int Job::getNumGpusPerNodeMin() const {
+	return numGpusPerNodeMin;
+}
+
+int Job::getNumGpusPerNodeMax() const {
+	return numGpusPerNodeMax;
+}
+
 double Job::getSubmitTime() const {
 	return submitTime;
 }
@@ -136,6 +231,41 @@ const Workload* Job::getWorkload() const {
 	return workload.get();
 }
 
+int Job::getTotalPhaseCount() const {
+	return workload ? workload->getTotalPhaseCount() : totalPhaseCount;
+}
+
+int Job::getCompletedPhases() const {
+	return workload ? workload->getCompletedPhases() : completedPhases;
+}
+
+const std::vector<Node*>& Job::getAssignedNodes() const {
+	return assignedNodes;
+}
+
+const NodeSet& Job::getAssignedNodeSet() const {
+	return assignedNodeSet;
+}
+
+int Job::getAssignedNumGpusPerNode() const {
+	return assignedNumGpusPerNode;
+}
+
+const std::map<std::string, std::string>& Job::getArguments() const {
+	return arguments;
+}
+
+const std::map<std::string, std::string>& Job::getAttributes() const {
+	return attributes;
+}
+
+std::map<std::string, std::string> Job::getRuntimeArguments() const {
+	runtimeArgumentsMutex->lock();
+	std::map<std::string, std::string> copy = runtimeArguments;
+	runtimeArgumentsMutex->unlock();
+	return copy;
+}
+
 const std::vector<Node*>& Job::getExecutingNodes() const {
 	return executingNodes;
 }
@@ -144,8 +274,102 @@ const std::vector<Node*>& Job::getExpandingNodes() const {
 	return expandingNodes;
 }
 
+const std::vector<Node*>& Job::getRedistributionSources() const {
+	return redistributionSources;
+}
+
+double Job::getRedistributionBytes() const {
+	return redistributionBytes;
+}
+
+double Job::getReconfigurationOverhead() const {
+	return reconfigurationOverhead;
+}
+
+double Job::getTotalReconfigurationOverhead() const {
+	return totalReconfigurationOverhead;
+}
+
+int Job::getNumReconfigurations() const {
+	return numReconfigurations;
+}
+
+bool Job::isRetainingNodes() const {
+	return retainingNodes;
+}
+
+double Job::getSuspendedTime() const {
+	return suspendedTime;
+}
+
+int Job::getNumSuspensions() const {
+	return numSuspensions;
+}
+
+double Job::getCheckpointOverhead() const {
+	return checkpointOverhead;
+}
+
+void Job::suspend(bool retainNodes) {
+	if (state == SUSPENDED || state == PENDING_SUSPENSION) {
+		// repeated decisions keep the job suspended as it is
+		return;
+	}
+	if (state != RUNNING && state != PENDING_RECONFIGURATION) {
+		xbt_die("Job %d can only be suspended while running", id);
+	}
+	retainingNodes = retainNodes;
+	setState(PENDING_SUSPENSION);
+}
+
+void Job::resume() {
+	if (state != SUSPENDED) {
+		xbt_die("Job %d is not suspended and can not be resumed", id);
+	}
+	if (retainingNodes && assignedNodeSet != executingNodeSet) {
+		xbt_die("Job %d retained its nodes while suspended and has to resume on them", id);
+	}
+	setState(PENDING_RESUMPTION);
+}
+
+double Job::calculateReconfigurationOverhead(size_t numNodes, size_t numSpawnedNodes) {
+	if (!Configuration::exists("reconfiguration_overhead")) {
+		return 0;
+	}
+	// fixed runtime cost, sequential process spawning, and a tree-shaped communicator rebuild
+	const nlohmann::json& model = Configuration::get("reconfiguration_overhead");
+	double overhead = model.value("fixed", 0.0) + model.value("spawn_per_node", 0.0) * (double) numSpawnedNodes;
+	if (numNodes > 1) {
+		overhead += model.value("rebuild_per_log_node", 0.0) * std::log2((double) numNodes);
+	}
+	return overhead;
+}
+
+double Job::calculateCheckpointOverhead(double stateBytes) {
+	if (!Configuration::exists("checkpoint_overhead")) {
+		return 0;
+	}
+	// fixed cost of the checkpoint library, writing the state and reading it back on restart
+	const nlohmann::json& model = Configuration::get("checkpoint_overhead");
+	double overhead = model.value("fixed", 0.0);
+	double bandwidth = model.value("bandwidth", 0.0);
+	if (bandwidth > 0) {
+		overhead += 2 * stateBytes / bandwidth;
+	}
+	return overhead;
+}
+
+const NodeSet& Job::getExecutingNodeSet() const {
+	return executingNodeSet;
+}
+
+const NodeSet& Job::getExpandingNodeSet() const {
+	return expandingNodeSet;
+}
+
 void Job::setExpandNodes(const std::vector<Node*> expandingNodes) {
 	Job::expandingNodes = expandingNodes;
+	expandingNodeSet = NodeSet(expandingNodes);
 	workload->scaleExpandPhaseTo(expandingNodes.size(), executingNumGpusPerNode, runtimeArguments);
 }
 
@@ -171,15 +395,25 @@ int Job::calculateEvolvingRequest(const std::string& evolvingModel, int phaseIte
 	return numberOfNodes;
 }
 
-void Job::assignNode(Node* node) {
-	if (state == PENDING) {
-		assignedNodes.push_back(node);
-	} else if (type == MALLEABLE || type == EVOLVING || type == ADAPTIVE) {
-		assignedNodes.push_back(node);
-		node->expectJob(this);
-	} else {
+void Job::assignNodes(const std::vector<Node*>& nodes) {
+	if (state != PENDING && state != SUSPENDED && !nodes.empty() && type != MALLEABLE && type != EVOLVING &&
+		type != ADAPTIVE) {
 		xbt_die("Assigning nodes during runtime not allowed for rigid/moldable job %d", id);
 	}
+	// only touch nodes whose expectation actually changes
+	NodeSet nodeSet(nodes);
+	for (const auto& node: (assignedNodeSet - nodeSet).resolve(PlatformManager::getComputeNodes())) {
+		node->removeExpectedJob(this);
+	}
+	if (state != PENDING) {
+		for (const auto& node: nodes) {
+			if (!node->isExpecting(this)) {
+				node->expectJob(this);
+			}
+		}
+	}
+	assignedNodes = nodes;
+	assignedNodeSet = std::move(nodeSet);
 }
 
 void Job::assignNumGpusPerNode(int numGpusPerNode) {
@@ -196,14 +430,64 @@ int Job::getExecutingNumGpusPerNode() const {
 
 void Job::advanceWorkload(int completedPhases, int remainingIterations) {
 	workload->advance(completedPhases, remainingIterations);
+	for (const auto& node: executingNodes) {
+		node->clearProgress(this);
+	}
+}
+
+std::pair<int, int> Job::getCheckpoint() const {
+	// the last phase iteration completed by all ranks, relative to the workload the ranks started with
+	if (executingNodes.empty()) {
+		return {-1, 0};
+	}
+	std::pair<int, int> checkpoint = executingNodes.front()->getProgress(this);
+	for (const auto& node: executingNodes) {
+		std::pair<int, int> progress = node->getProgress(this);
+		if (progress.first < checkpoint.first ||
+			(progress.first == checkpoint.first && progress.second > checkpoint.second)) {
+			checkpoint = progress;
+		}
+	}
+	return checkpoint;
+}
+
+double Job::estimateRuntime(int numNodes, int numGpusPerNode) const {
+	const std::vector<Node*>& computeNodes = PlatformManager::getComputeNodes();
+	if (numNodes <= 0 || numNodes > computeNodes.size()) {
+		return std::numeric_limits<double>::infinity();
+	}
+	// the executing nodes stand in first, the remaining ranks take the next compute nodes in order
+	std::vector<Node*> nodes;
+	nodes.reserve(numNodes);
+	for (const auto& node: executingNodes) {
+		if (nodes.size() < numNodes) {
+			nodes.push_back(node);
+		}
+	}
+	for (const auto& node: computeNodes) {
+		if (nodes.size() < numNodes && !executingNodeSet.contains(node)) {
+			nodes.push_back(node);
+		}
+	}
+	auto [completedPhases, remainingIterations] = getCheckpoint();
+	return workload->estimate(nodes, numGpusPerNode, runtimeArguments, completedPhases, remainingIterations);
 }
 
 void Job::completeWorkload() {
 	workload->complete();
 }
 
+void Job::releaseWorkload() {
+	totalPhaseCount = workload->getTotalPhaseCount();
+	completedPhases = workload->getCompletedPhases();
+	workload.reset();
+	expandingNodes.clear();
+	expandingNodeSet.clear();
+}
+
 void Job::updateState() {
-	if (assignedNodes != executingNodes) {
+	// a permutation of the executing nodes changes the ranks and reconfigures the job as well
+	if (assignedNodeSet != executingNodeSet || assignedNodes != executingNodes) {
 		if (state == PENDING) {
 			state = PENDING_ALLOCATION;
 			PlatformManager::addModifiedJob(this);
@@ -219,22 +503,17 @@ void Job::updateState() {
 	}
 }
 
-void Job::clearAssignedNodes() {
-	for (const auto& node: assignedNodes) {
-		node->removeExpectedJob(this);
-	}
-	assignedNodes.clear();
-}
-
 void Job::updateRuntimeArguments(const std::string& key, const std::string& value) {
 	runtimeArgumentsMutex->lock();
 	runtimeArguments[key] = value;
+	workload->clearEstimates();
 	runtimeArgumentsMutex->unlock();
 }
 
 void Job::clearRuntimeArguments() {
 	runtimeArgumentsMutex->lock();
 	runtimeArguments.clear();
+	workload->clearEstimates();
 	runtimeArgumentsMutex->unlock();
 }
 
@@ -301,9 +580,19 @@ nlohmann::json Job::toJson() const {
 	json["wait_time"] = waitTime;
 	json["makespan"] = makespan;
 	json["turnaround_time"] = turnaroundTime;
-	json["assigned_nodes"] = nlohmann::json::array();
-	for (const auto& node: assignedNodes) {
-		json["assigned_nodes"].push_back(node->getId());
+	json["num_reconfigurations"] = numReconfigurations;
+	json["reconfiguration_overhead"] = totalReconfigurationOverhead;
+	json["num_suspensions"] = numSuspensions;
+	json["suspended_time"] = suspendedTime;
+	if (NodeAllocator::isEnabled()) {
+		json["assigned_node_counts"] = NodeAllocator::countNodes(assignedNodes);
+	} else if (compressNodeIds) {
+		json["assigned_nodes"] = Utility::compressNodeIds(assignedNodes);
+	} else {
+		json["assigned_nodes"] = nlohmann::json::array();
+		for (const auto& node: assignedNodes) {
+			json["assigned_nodes"].push_back(node->getId());
+		}
 	}
 	json["assigned_num_gpus_per_node"] = assignedNumGpusPerNode;
 	for (const auto& [key, value]: arguments) {
@@ -315,7 +604,7 @@ nlohmann::json Job::toJson() const {
 	for (const auto& [key, value]: runtimeArguments) {
 		json["runtime_arguments"][key] = value;
 	}
-	json["total_phase_count"] = workload->getTotalPhaseCount();
-	json["completed_phases"] = workload->getCompletedPhases();
+	json["total_phase_count"] = getTotalPhaseCount();
+	json["completed_phases"] = getCompletedPhases();
 	return json;
 }
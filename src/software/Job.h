@@ -15,6 +15,7 @@
 #include <simgrid/s4u.hpp>
 #include <list>
 #include <json.hpp>
+#include "NodeSet.h"
 
 class Node;
 
@@ -37,7 +38,10 @@ enum JobState {
 	PENDING_RECONFIGURATION = 5,
 	IN_RECONFIGURATION = 6,
 	COMPLETED = 7,
-	KILLED = 8
+	KILLED = 8,
+	PENDING_SUSPENSION = 9,
+	SUSPENDED = 10,
+	PENDING_RESUMPTION = 11
 };
 
 class Job {
@@ -60,9 +64,15 @@ private:
 	double makespan;
 	double turnaroundTime;
 	std::unique_ptr<Workload> workload;
+	int totalPhaseCount;
+	int completedPhases;
 	std::vector<Node*> assignedNodes;
 	std::vector<Node*> executingNodes;
 	std::vector<Node*> expandingNodes;
+	std::vector<Node*> redistributionSources;
+	NodeSet assignedNodeSet;
+	NodeSet executingNodeSet;
+	NodeSet expandingNodeSet;
 	std::map<std::string, std::string> arguments;
 	std::map<std::string, std::string> attributes;
 	std::map<std::string, std::string> runtimeArguments;
@@ -70,7 +80,21 @@ private:
 	simgrid::s4u::MutexPtr runtimeArgumentsMutex;
 	int assignedNumGpusPerNode;
 	int executingNumGpusPerNode;
+	double redistributionBytes;
+	double reconfigurationOverhead;
+	double totalReconfigurationOverhead;
+	int numReconfigurations;
+	bool retainingNodes;
+	double suspensionStart;
+	double suspendedTime;
+	int numSuspensions;
+	double checkpointOverhead;
 	const bool clipEvolvingRequests;
+	const bool compressNodeIds;
+
+	[[nodiscard]] static double calculateReconfigurationOverhead(size_t numNodes, size_t numSpawnedNodes);
+
+	[[nodiscard]] static double calculateCheckpointOverhead(double stateBytes);
 
 public:
 	Job(int walltime, int numNodes, int numGpusPerNode, double submitTime,
@@ -93,6 +117,18 @@ public:
 
 	[[nodiscard]] double getWalltime() const;
 
+	[[nodiscard]] int getNumNodes() const;
+
+	[[nodiscard]] int getNumGpusPerNode() const;
+
+	[[nodiscard]] int getNumNodesMin() const;
+
+	[[nodiscard]] int getNumNodesMax() const;
+
+	[[nodiscard]] int getNumGpusPerNodeMin() const;
+
+	[[nodiscard]] int getNumGpusPerNodeMax() const;
+
 	[[nodiscard]] double getSubmitTime() const;
 
 	[[nodiscard]] double getStartTime() const;
@@ -107,15 +143,57 @@ public:
 
 	[[nodiscard]] const Workload* getWorkload() const;
 
+	[[nodiscard]] int getTotalPhaseCount() const;
+
+	[[nodiscard]] int getCompletedPhases() const;
+
+	[[nodiscard]] const std::vector<Node*>& getAssignedNodes() const;
+
+	[[nodiscard]] const NodeSet& getAssignedNodeSet() const;
+
+	[[nodiscard]] int getAssignedNumGpusPerNode() const;
+
+	[[nodiscard]] const std::map<std::string, std::string>& getArguments() const;
+
+	[[nodiscard]] const std::map<std::string, std::string>& getAttributes() const;
+
+	[[nodiscard]] std::map<std::string, std::string> getRuntimeArguments() const;
+
 	[[nodiscard]] const std::vector<Node*>& getExecutingNodes() const;
 
 	[[nodiscard]] const std::vector<Node*>& getExpandingNodes() const;
 
+	[[nodiscard]] const NodeSet& getExecutingNodeSet() const;
+
+	[[nodiscard]] const NodeSet& getExpandingNodeSet() const;
+
 	void setExpandNodes(std::vector<Node*> expandingNodes);
 
+	[[nodiscard]] const std::vector<Node*>& getRedistributionSources() const;
+
+	[[nodiscard]] double getRedistributionBytes() const;
+
+	[[nodiscard]] double getReconfigurationOverhead() const;
+
+	[[nodiscard]] double getTotalReconfigurationOverhead() const;
+
+	[[nodiscard]] int getNumReconfigurations() const;
+
+	[[nodiscard]] bool isRetainingNodes() const;
+
+	[[nodiscard]] double getSuspendedTime() const;
+
+	[[nodiscard]] int getNumSuspensions() const;
+
+	[[nodiscard]] double getCheckpointOverhead() const;
+
+	void suspend(bool retainNodes);
+
+	void resume();
+
 	[[nodiscard]] int calculateEvolvingRequest(const std::string& evolvingModel, int phaseIteration);
 
-	void assignNode(Node* node);
+	void assignNodes(const std::vector<Node*>& nodes);
 
 	void assignNumGpusPerNode(int numGpusPerNode);
 
@@ -125,11 +203,15 @@ public:
 
 	void advanceWorkload(int completedPhases, int remainingIterations);
 
+	[[nodiscard]] std::pair<int, int> getCheckpoint() const;
+
+	[[nodiscard]] double estimateRuntime(int numNodes, int numGpusPerNode) const;
+
 	void completeWorkload();
 
-	void updateState();
+	void releaseWorkload();
 
-	void clearAssignedNodes();
+	void updateState();
 
 	void updateRuntimeArguments(const std::string& key, const std::string& value);
 
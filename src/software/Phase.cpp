@@ -10,13 +10,15 @@
 
 #include "Phase.h"
 
+#include <algorithm>
 #include <utility>
 #include "Task.h"
 
 Phase::Phase(std::deque<std::unique_ptr<Task>> tasks, int iterations, bool schedulingPoint, std::string evolvingModel,
-			 bool barrier) :
-		tasks(std::move(tasks)), iterations(iterations), initialIterations(iterations),
-		schedulingPoint(schedulingPoint), evolvingModel(std::move(evolvingModel)), barrier(barrier) {
+			 bool barrier, std::vector<std::vector<size_t>> dependencies) :
+		tasks(std::move(tasks)), dependencies(std::move(dependencies)), iterations(iterations),
+		initialIterations(iterations), schedulingPoint(schedulingPoint), evolvingModel(std::move(evolvingModel)),
+		barrier(barrier) {
 	for (const auto& task: Phase::tasks) {
 		taskPointers.push_back(task.get());
 	}
@@ -26,6 +28,14 @@ const std::deque<const Task*>& Phase::getTasks() const {
 	return taskPointers;
 }
 
+bool Phase::hasDependencies() const {
+	return !dependencies.empty();
+}
+
+const std::vector<std::vector<size_t>>& Phase::getDependencies() const {
+	return dependencies;
+}
+
 int Phase::getIterations() const {
 	return iterations;
 }
@@ -59,3 +69,23 @@ void Phase::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string
 		task->scaleTo(numNodes, numGpusPerNode, runtimeArguments);
 	}
 }
+
+double Phase::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+								const std::map<std::string, std::string>& runtimeArguments) const {
+	// tasks run one after another, or along the longest chain of dependencies if the phase declares them
+	std::vector<double> finishTimes(tasks.size());
+	double time = 0;
+	for (size_t i = 0; i < tasks.size(); ++i) {
+		double startTime = 0;
+		if (dependencies.empty()) {
+			startTime = i > 0 ? finishTimes[i - 1] : 0;
+		} else {
+			for (size_t dependency: dependencies[i]) {
+				startTime = std::max(startTime, finishTimes[dependency]);
+			}
+		}
+		finishTimes[i] = startTime + tasks[i]->estimate(nodes, numGpusPerNode, runtimeArguments);
+		time = std::max(time, finishTimes[i]);
+	}
+	return time;
+}
@@ -16,14 +16,18 @@
 #include <memory>
 #include <map>
 #include <string>
+#include <vector>
 
 class Task;
 
+class Node;
+
 class Phase {
 
 private:
 	std::deque<std::unique_ptr<Task>> tasks;
 	std::deque<const Task*> taskPointers;
+	const std::vector<std::vector<size_t>> dependencies;
 	int iterations;
 	int initialIterations;
 	const bool schedulingPoint;
@@ -32,10 +36,14 @@ private:
 
 public:
 	Phase(std::deque<std::unique_ptr<Task>> tasks, int iterations, bool schedulingPoint, std::string evolvingModel,
-		  bool barrier);
+		  bool barrier, std::vector<std::vector<size_t>> dependencies);
 
 	[[nodiscard]] const std::deque<const Task*>& getTasks() const;
 
+	[[nodiscard]] bool hasDependencies() const;
+
+	[[nodiscard]] const std::vector<std::vector<size_t>>& getDependencies() const;
+
 	[[nodiscard]] int getIterations() const;
 
 	void setIterations(int iterations);
@@ -52,6 +60,9 @@ public:
 
 	void scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments);
 
+	[[nodiscard]] double estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+										   const std::map<std::string, std::string>& runtimeArguments) const;
+
 };
 
 
@@ -10,15 +10,17 @@
 
 #include "Workload.h"
 
+#include <algorithm>
 #include <utility>
 #include "Phase.h"
 #include "Task.h"
 
 
 Workload::Workload(std::unique_ptr<Phase> initPhase, std::unique_ptr<Phase> reconfigurationPhase,
-				   std::unique_ptr<Phase> expansionPhase, std::deque<std::unique_ptr<Phase>> phases)
+				   std::unique_ptr<Phase> expansionPhase, std::deque<std::unique_ptr<Phase>> phases,
+				   std::string stateModel)
 		: initPhase(std::move(initPhase)), reconfigurationPhase(std::move(reconfigurationPhase)),
-		  expansionPhase(std::move(expansionPhase)), phases(std::move(phases)) {
+		  expansionPhase(std::move(expansionPhase)), phases(std::move(phases)), stateModel(std::move(stateModel)) {
 	totalPhaseCount = 0;
 	for (const auto& phase: Workload::phases) {
 		totalPhaseCount += phase->getIterations();
@@ -43,6 +45,10 @@ const std::deque<const Phase*>& Workload::getPhases() const {
 	return phasePointers;
 }
 
+const std::string& Workload::getStateModel() const {
+	return stateModel;
+}
+
 int Workload::getTotalPhaseCount() const {
 	return totalPhaseCount;
 }
@@ -80,6 +86,9 @@ void Workload::advance(int completedPhases, int remainingIterations) {
 		Workload::completedPhases += phases.front()->getIterations();
 		phases.pop_front();
 		phasePointers.pop_front();
+		for (auto& [configuration, estimates]: iterationEstimates) {
+			estimates.pop_front();
+		}
 	}
 	if (remainingIterations > 0) {
 		Workload::completedPhases += (phases.front()->getIterations() - remainingIterations);
@@ -90,4 +99,33 @@ void Workload::advance(int completedPhases, int remainingIterations) {
 void Workload::complete() {
 	phases.clear();
 	completedPhases = totalPhaseCount;
+	iterationEstimates.clear();
+}
+
+double Workload::estimate(const std::vector<Node*>& nodes, int numGpusPerNode,
+						  const std::map<std::string, std::string>& runtimeArguments, int completedPhases,
+						  int remainingIterations) const {
+	// phases are only estimated once per configuration, progress just selects the iterations left
+	auto configuration = std::make_pair((int) nodes.size(), numGpusPerNode);
+	auto it = iterationEstimates.find(configuration);
+	if (it == iterationEstimates.end()) {
+		std::deque<double> estimates;
+		for (const auto& phase: phases) {
+			estimates.push_back(phase->estimateIteration(nodes, numGpusPerNode, runtimeArguments));
+		}
+		it = iterationEstimates.emplace(configuration, std::move(estimates)).first;
+	}
+	double runtime = 0;
+	for (size_t i = std::max(completedPhases, 0); i < phases.size(); ++i) {
+		int iterations = phases[i]->getIterations();
+		if ((int) i == completedPhases && remainingIterations > 0) {
+			iterations = remainingIterations;
+		}
+		runtime += iterations * it->second[i];
+	}
+	return runtime;
+}
+
+void Workload::clearEstimates() {
+	iterationEstimates.clear();
 }
@@ -14,11 +14,16 @@
 #include <memory>
 #include <queue>
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 class Task;
 
 class Phase;
 
+class Node;
+
 class Workload {
 
 private:
@@ -27,12 +32,16 @@ private:
 	std::unique_ptr<Phase> expansionPhase;
 	std::deque<std::unique_ptr<Phase>> phases;
 	std::deque<const Phase*> phasePointers;
+	const std::string stateModel;
 	int totalPhaseCount;
 	int completedPhases;
+	// time per iteration of the remaining phases, by number of nodes and GPUs per node on the representative nodes
+	// of the job, which depend on its executing nodes and are cleared whenever these change
+	mutable std::map<std::pair<int, int>, std::deque<double>> iterationEstimates;
 
 public:
 	Workload(std::unique_ptr<Phase> initPhase, std::unique_ptr<Phase> reconfigurationPhase,
-			 std::unique_ptr<Phase> expansionPhase, std::deque<std::unique_ptr<Phase>> phases);
+			 std::unique_ptr<Phase> expansionPhase, std::deque<std::unique_ptr<Phase>> phases, std::string stateModel);
 
 	[[nodiscard]] const Phase* getInitPhase() const;
 
@@ -42,6 +51,8 @@ public:
 
 	[[nodiscard]] const std::deque<const Phase*>& getPhases() const;
 
+	[[nodiscard]] const std::string& getStateModel() const;
+
 	[[nodiscard]] int getTotalPhaseCount() const;
 
 	[[nodiscard]] int getCompletedPhases() const;
@@ -56,6 +67,12 @@ public:
 
 	void advance(int completedPhases, int remainingIterations);
 
+	[[nodiscard]] double estimate(const std::vector<Node*>& nodes, int numGpusPerNode,
+								  const std::map<std::string, std::string>& runtimeArguments, int completedPhases,
+								  int remainingIterations) const;
+
+	void clearEstimates();
+
 	void complete();
 };
 
@@ -10,6 +10,7 @@
 
 #include "Gpu.h"
 #include "AsyncSleep.h"
+#include "Profiler.h"
 
 Gpu::Gpu(int id, long processingSpeed, s4u_Host* host) :
 		id(id), state(GPU_FREE), processingSpeed(processingSpeed), host(host), utilization(0.0),
@@ -45,13 +46,15 @@ void Gpu::exec(double flops) {
 	deallocate();
 }
 
-s4u_Mailbox* Gpu::execAsync(double flops) {
+std::pair<s4u_Mailbox*, aid_t> Gpu::execAsync(double flops) {
 	s4u_Mailbox* callback = s4u_Mailbox::by_name(
 			"Kernel" + std::to_string(kernelId++) + "@GPU" + std::to_string(id) + "@" + host->get_name());
-	s4u_Actor::create("GPU" + std::to_string(id) + "@" + host->get_name(), host,
-					  AsyncSleep(flops / processingSpeed, [this]() { allocate(); }, [this]() { deallocate(); },
-								 callback, callback));
-	return callback;
+	Profiler::count(COUNT_GPU_ACTORS);
+	simgrid::s4u::ActorPtr kernel = s4u_Actor::create(
+			"GPU" + std::to_string(id) + "@" + host->get_name(), host,
+			AsyncSleep(flops / processingSpeed, [this]() { allocate(); }, [this]() { deallocate(); }, callback,
+					   callback));
+	return {callback, kernel->get_pid()};
 }
 
 nlohmann::json Gpu::toJson() {
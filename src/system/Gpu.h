@@ -11,6 +11,7 @@
 #ifndef ELASTISIM_GPU_H
 #define ELASTISIM_GPU_H
 
+#include <utility>
 #include <simgrid/s4u.hpp>
 #include <json.hpp>
 
@@ -45,7 +46,7 @@ public:
 
 	void exec(double flops);
 
-	[[nodiscard]] s4u_Mailbox* execAsync(double flops);
+	[[nodiscard]] std::pair<s4u_Mailbox*, aid_t> execAsync(double flops);
 
 	nlohmann::json toJson();
 };
@@ -14,22 +14,24 @@
 #include "Job.h"
 #include "Workload.h"
 #include "Phase.h"
-#include "Utility.h"
+#include "Task.h"
 #include "SimMsg.h"
-#include "Configuration.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(User, "Messages within the JobSubmitter actor");
 
+JobSubmitter::JobSubmitter(std::vector<std::unique_ptr<Job>> jobs) :
+		jobs(std::make_shared<std::vector<std::unique_ptr<Job>>>(std::move(jobs))) {}
+
 void JobSubmitter::operator()() {
 
 	s4u_Mailbox* mailboxSimulator = s4u_Mailbox::by_name("SimulationEngine");
-	std::vector<std::unique_ptr<Job>> jobs(Utility::readJobs(Configuration::get("jobs_file")));
-	std::stable_sort(std::begin(jobs), std::end(jobs), [](const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b) {
-		return a->getSubmitTime() < b->getSubmitTime();
-	});
-	mailboxSimulator->put(new SimMsg(NUMBER_OF_JOBS, jobs.size()), 0);
+	std::stable_sort(std::begin(*jobs), std::end(*jobs),
+					 [](const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b) {
+						 return a->getSubmitTime() < b->getSubmitTime();
+					 });
+	mailboxSimulator->put(new SimMsg(NUMBER_OF_JOBS, jobs->size()), 0);
 
-	for (auto& job: jobs) {
+	for (auto& job: *jobs) {
 		simgrid::s4u::this_actor::sleep_until(job->getSubmitTime());
 		mailboxSimulator->put(new SimMsg(SUBMIT_JOB, std::move(job)), 0);
 	}
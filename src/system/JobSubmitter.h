@@ -19,7 +19,12 @@ class Job;
 
 class JobSubmitter {
 
+private:
+	std::shared_ptr<std::vector<std::unique_ptr<Job>>> jobs;
+
 public:
+	explicit JobSubmitter(std::vector<std::unique_ptr<Job>> jobs);
+
 	void operator()();
 
 };
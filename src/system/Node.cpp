@@ -10,6 +10,7 @@
 
 #include "Node.h"
 
+#include <algorithm>
 #include <simgrid/s4u.hpp>
 #include <utility>
 
@@ -20,19 +21,27 @@
 #include "AsyncSleep.h"
 #include "Configuration.h"
 #include "PlatformManager.h"
+#include "Profiler.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(ComputeNode, "Messages within the Compute Node actor");
 
-Node::Node(int id, NodeType type, s4u_Host* host, s4u_Disk* nodeLocalBurstBuffer,
-		   std::vector<s4u_Host*> pfsHosts, double flopsPerByte, std::vector<std::unique_ptr<Gpu>> gpus,
-		   long gpuToGpuBandwidth, std::ofstream& nodeUtilizationOutput, std::ofstream& taskTimes) :
-		id(id), type(type), host(host), nodeLocalBurstBuffer(nodeLocalBurstBuffer), pfsHosts(std::move(pfsHosts)),
-		state(NODE_FREE), nodeUtilizationOutput(nodeUtilizationOutput), flopsPerByte(flopsPerByte),
-		gpus(std::move(gpus)), gpuToGpuBandwidth(gpuToGpuBandwidth), gpuLinkMutex(s4u_Mutex::create()),
+Node::Node(int id, const NodeClass* nodeClass, s4u_Host* host, std::ofstream& nodeUtilizationOutput,
+		   std::ofstream& taskTimes) :
+		id(id), nodeClass(nodeClass), host(host), nodeLocalBurstBuffer(nullptr), state(NODE_FREE),
+		nodeUtilizationOutput(nodeUtilizationOutput), gpuLinkMutex(s4u_Mutex::create()),
 		allowOversubscription(Configuration::getBoolIfExists("allow_oversubscription")),
 		logTaskTimes(taskTimes.is_open()), taskTimes(taskTimes) {
-	for (const auto& gpu: Node::gpus) {
-		gpuPointers.push_back(gpu.get());
+	if (nodeClass->hasNodeLocalBurstBuffer()) {
+		nodeLocalBurstBuffer = host->create_disk("BurstBuffer@" + host->get_name(),
+												 nodeClass->getBurstBufferReadBandwidth(),
+												 nodeClass->getBurstBufferWriteBandwidth());
+		nodeLocalBurstBuffer->seal();
+	}
+	gpus.reserve(nodeClass->getNumGpus());
+	gpuPointers.reserve(nodeClass->getNumGpus());
+	for (int i = 0; i < nodeClass->getNumGpus(); ++i) {
+		gpus.push_back(std::make_unique<Gpu>(i, nodeClass->getFlopsPerGpu(), host));
+		gpuPointers.push_back(gpus.back().get());
 	}
 	collectStatistics();
 	PlatformManager::addModifiedComputeNode(this);
@@ -74,7 +83,7 @@ void Node::collectStatistics() {
 						  << expectedJobIds << std::endl;
 }
 
-void Node::allocateJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBarrier) {
+void Node::allocateJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBarrier, bool restart) {
 	if (!allowOversubscription && !runningJobs.empty()) {
 		xbt_die("Node %d already allocated to job %d and cannot be assigned to job %d", id,
 				(*runningJobs.begin())->getId(), job->getId());
@@ -84,27 +93,26 @@ void Node::allocateJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBa
 	initializing[job] = true;
 	reconfiguring[job] = false;
 	expanding[job] = false;
+	restarting[job] = restart;
+	suspended[job] = false;
 	runningJobs.insert(job);
 	if (!runningJobs.empty()) {
 		state = NODE_ALLOCATED;
 	}
 	PlatformManager::addModifiedComputeNode(this);
 	collectStatistics();
-	application[job] = s4u_Actor::create("Application@Job" + std::to_string(job->getId()), host,
-										 Application(this, job, assignedRank[job], logTaskTimes));
+	launchApplication(job);
 }
 
 void Node::continueJob(Job* job) {
-	application[job] = s4u_Actor::create("Application@Job" + std::to_string(job->getId()), host,
-										 Application(this, job, assignedRank[job], logTaskTimes));
+	launchApplication(job);
 }
 
 void Node::reconfigureJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBarrier) {
 	assignedRank[job] = rank;
 	barrier[job] = jobBarrier;
 	reconfiguring[job] = true;
-	application[job] = s4u_Actor::create("Application@Job" + std::to_string(job->getId()), host,
-										 Application(this, job, assignedRank[job], logTaskTimes));
+	launchApplication(job);
 }
 
 void Node::expandJob(Job* job, int rank, int expandRank,
@@ -117,18 +125,45 @@ void Node::expandJob(Job* job, int rank, int expandRank,
 	initializing[job] = false;
 	reconfiguring[job] = true;
 	expanding[job] = true;
+	restarting[job] = false;
+	suspended[job] = false;
 	runningJobs.insert(job);
 	if (!runningJobs.empty()) {
 		state = NODE_ALLOCATED;
 	}
 	PlatformManager::addModifiedComputeNode(this);
 	collectStatistics();
+	launchApplication(job);
+}
+
+void Node::launchApplication(Job* job) {
+	// progress is recorded relative to the workload the application starts with
+	clearProgress(job);
+	exited[job] = false;
+	Profiler::count(COUNT_APPLICATION_ACTORS);
 	application[job] = s4u_Actor::create("Application@Job" + std::to_string(job->getId()), host,
 										 Application(this, job, assignedRank[job], logTaskTimes));
 }
 
-void Node::completeJob(Job* job) {
+void Node::releaseJob(Job* job) {
+	assignedRank.erase(job);
+	assignedExpandRank.erase(job);
 	application.erase(job);
+	barrier.erase(job);
+	expandBarrier.erase(job);
+	initializing.erase(job);
+	reconfiguring.erase(job);
+	expanding.erase(job);
+	restarting.erase(job);
+	suspended.erase(job);
+	exited.erase(job);
+	progress.erase(job);
+	trackedActivities.erase(job);
+	helperActors.erase(job);
+}
+
+void Node::completeJob(Job* job) {
+	releaseJob(job);
 	runningJobs.erase(job);
 	if (runningJobs.empty()) {
 		state = NODE_FREE;
@@ -139,7 +174,7 @@ void Node::completeJob(Job* job) {
 
 void Node::killJob(Job* job) {
 	application[job]->kill();
-	application.erase(job);
+	releaseJob(job);
 	runningJobs.erase(job);
 	if (runningJobs.empty()) {
 		state = NODE_FREE;
@@ -148,12 +183,65 @@ void Node::killJob(Job* job) {
 	collectStatistics();
 }
 
+void Node::suspendJob(Job* job) {
+	if (exited[job]) {
+		// the application already left at a scheduling point, resuming launches it again
+		return;
+	}
+	// suspending the actor only suspends the activity it is blocked on, the activities and helper actors it left
+	// running (asynchronous tasks, burst buffer stripes, GPU kernels and GPU link transfers) are suspended one by one
+	for (const auto& activity: trackedActivities[job]) {
+		if (activity->get_state() == simgrid::s4u::Activity::State::STARTED && !activity->is_suspended()) {
+			activity->suspend();
+		}
+	}
+	for (aid_t pid: helperActors[job]) {
+		if (simgrid::s4u::ActorPtr actor = simgrid::s4u::Actor::by_pid(pid)) {
+			actor->suspend();
+		}
+	}
+	application[job]->suspend();
+	suspended[job] = true;
+}
+
+void Node::resumeJob(Job* job) {
+	if (suspended[job]) {
+		for (const auto& activity: trackedActivities[job]) {
+			if (activity->is_suspended()) {
+				activity->resume();
+			}
+		}
+		for (aid_t pid: helperActors[job]) {
+			if (simgrid::s4u::ActorPtr actor = simgrid::s4u::Actor::by_pid(pid)) {
+				actor->resume();
+			}
+		}
+		application[job]->resume();
+		suspended[job] = false;
+	} else {
+		// suspended at a scheduling point, after the application left
+		continueJob(job);
+	}
+}
+
 int Node::getId() const {
 	return id;
 }
 
+const NodeClass* Node::getNodeClass() const {
+	return nodeClass;
+}
+
 NodeType Node::getType() const {
-	return type;
+	return nodeClass->getType();
+}
+
+NodeState Node::getState() const {
+	return state;
+}
+
+const std::set<Job*>& Node::getRunningJobs() const {
+	return runningJobs;
 }
 
 s4u_Host* Node::getHost() const {
@@ -169,11 +257,11 @@ s4u_Disk* Node::getNodeLocalBurstBuffer() const {
 }
 
 const std::vector<s4u_Host*>& Node::getPfsHosts() const {
-	return pfsHosts;
+	return nodeClass->getPfsHosts();
 }
 
 double Node::getFlopsPerByte() const {
-	return flopsPerByte;
+	return nodeClass->getFlopsPerByte();
 }
 
 const std::vector<const Gpu*>& Node::getGpus() const {
@@ -181,10 +269,10 @@ const std::vector<const Gpu*>& Node::getGpus() const {
 }
 
 long Node::getGpuToGpuBandwidth() const {
-	return gpuToGpuBandwidth;
+	return nodeClass->getGpuToGpuBandwidth();
 }
 
-std::vector<s4u_Mailbox*> Node::execGpuComputationAsync(int numGpus, double flopsPerGpu) const {
+std::vector<s4u_Mailbox*> Node::execGpuComputationAsync(const Job* job, int numGpus, double flopsPerGpu) const {
 	if (numGpus == 1) {
 		XBT_INFO("Processing %f FLOPS on one GPU", flopsPerGpu);
 	} else {
@@ -203,7 +291,9 @@ std::vector<s4u_Mailbox*> Node::execGpuComputationAsync(int numGpus, double flop
 	std::vector<s4u_Mailbox*> gpuCallbacks;
 	gpuCallbacks.reserve(numGpus);
 	for (int i = 0; i < numGpus; ++i) {
-		gpuCallbacks.push_back(gpuCandidates[i]->execAsync(flopsPerGpu));
+		auto [gpuCallback, pid] = gpuCandidates[i]->execAsync(flopsPerGpu);
+		gpuCallbacks.push_back(gpuCallback);
+		trackHelperActor(job, pid);
 	}
 	return gpuCallbacks;
 }
@@ -216,27 +306,56 @@ void Node::releaseGpuLink() const {
 	gpuLinkMutex->unlock();
 }
 
-s4u_Mailbox* Node::execGpuTransferAsync(const std::vector<double>& bytes, int numGpus) const {
-	s4u_Mailbox* gpuLinkCallback = s4u_Mailbox::by_name("GPULink@" + getHostName());
-
-	int gpuPairs = ((numGpus - 1) * numGpus) / 2;
-	std::vector<double> exchangedBytes(gpuPairs);
+double Node::getDominantGpuTransfer(const std::vector<double>& bytes, int numGpus) {
 	double maxBytes = 0;
 	for (int i = 0; i < numGpus; ++i) {
 		for (int j = i + 1; j < numGpus; ++j) {
 			maxBytes = std::max(maxBytes, bytes[i * numGpus + j] + bytes[j * numGpus + i]);
 		}
 	}
+	return maxBytes;
+}
+
+s4u_Mailbox* Node::execGpuTransferAsync(const Job* job, const std::vector<double>& bytes, int numGpus) const {
+	double maxBytes = getDominantGpuTransfer(bytes, numGpus);
 	XBT_INFO("Transferring intra-node communication (dominant communication %f bytes) via GPU link", maxBytes);
-	s4u_Actor::create("GPULink@" + getHostName(), host,
-					  AsyncSleep(maxBytes / gpuToGpuBandwidth,
-								 [this]() { this->occupyGpuLink(); },
-								 [this]() { this->releaseGpuLink(); },
-								 gpuLinkCallback, gpuLinkCallback));
+	return execGpuTransferAsync(job, maxBytes);
+}
+
+s4u_Mailbox* Node::execGpuTransferAsync(const Job* job, double bytes) const {
+	s4u_Mailbox* gpuLinkCallback = s4u_Mailbox::by_name("GPULink@" + getHostName());
+	Profiler::count(COUNT_GPU_LINK_ACTORS);
+	simgrid::s4u::ActorPtr transfer = s4u_Actor::create("GPULink@" + getHostName(), host,
+														AsyncSleep(bytes / nodeClass->getGpuToGpuBandwidth(),
+																   [this]() { this->occupyGpuLink(); },
+																   [this]() { this->releaseGpuLink(); },
+																   gpuLinkCallback, gpuLinkCallback));
+	trackHelperActor(job, transfer->get_pid());
 
 	return gpuLinkCallback;
 }
 
+void Node::trackHelperActor(const Job* job, aid_t pid) const {
+	std::vector<aid_t>& pids = helperActors[job];
+	pids.erase(std::remove_if(std::begin(pids), std::end(pids),
+							  [](aid_t helper) { return simgrid::s4u::Actor::by_pid(helper) == nullptr; }),
+			   std::end(pids));
+	pids.push_back(pid);
+}
+
+std::vector<simgrid::s4u::ActivityPtr>
+Node::trackActivities(const Job* job, std::vector<simgrid::s4u::ActivityPtr> activities) const {
+	// activities are dropped once they are over, the application waits for all of them before it exits
+	std::vector<simgrid::s4u::ActivityPtr>& tracked = trackedActivities[job];
+	tracked.erase(std::remove_if(std::begin(tracked), std::end(tracked),
+								 [](const simgrid::s4u::ActivityPtr& activity) {
+									 return activity->get_state() != simgrid::s4u::Activity::State::STARTED;
+								 }),
+				  std::end(tracked));
+	tracked.insert(std::end(tracked), std::begin(activities), std::end(activities));
+	return activities;
+}
+
 const simgrid::s4u::BarrierPtr& Node::getBarrier(Job* job) const {
 	return barrier.at(job);
 }
@@ -269,6 +388,36 @@ void Node::markExpanded(Job* job) {
 	expanding[job] = false;
 }
 
+bool Node::isRestarting(Job* job) const {
+	return restarting.at(job);
+}
+
+void Node::markRestarted(Job* job) {
+	restarting[job] = false;
+}
+
+bool Node::hasExited(Job* job) const {
+	auto it = exited.find(job);
+	return it != exited.end() && it->second;
+}
+
+void Node::markExited(Job* job) {
+	exited[job] = true;
+}
+
+void Node::recordProgress(const Job* job, int completedPhases, int remainingIterations) {
+	progress[job] = {completedPhases, remainingIterations};
+}
+
+std::pair<int, int> Node::getProgress(const Job* job) const {
+	auto it = progress.find(job);
+	return it != progress.end() ? it->second : std::make_pair(-1, 0);
+}
+
+void Node::clearProgress(const Job* job) {
+	progress.erase(job);
+}
+
 int Node::getExpandRank(Job* job) const {
 	return assignedExpandRank.at(job);
 }
@@ -297,6 +446,10 @@ void Node::removeExpectedJob(Job* job) {
 	PlatformManager::addModifiedComputeNode(this);
 }
 
+bool Node::isExpecting(Job* job) const {
+	return expectedJobs.find(job) != expectedJobs.end();
+}
+
 void Node::logTaskTime(const Job* job, const Task* task, double duration) const {
 	taskTimes << simgrid::s4u::Engine::get_clock() << "," << job->getId() << "," << getHostName() << ","
 			  << task->getName() << "," << duration << std::endl;
@@ -305,7 +458,7 @@ void Node::logTaskTime(const Job* job, const Task* task, double duration) const
 nlohmann::json Node::toJson() {
 	nlohmann::json json;
 	json["id"] = id;
-	json["type"] = type;
+	json["type"] = nodeClass->getType();
 	json["state"] = state;
 	json["assigned_jobs"] = nlohmann::json::array();
 	for (const auto& job: runningJobs) {
@@ -17,6 +17,7 @@
 #include <json.hpp>
 #include <stack>
 #include "Gpu.h"
+#include "NodeClass.h"
 
 class Task;
 
@@ -24,12 +25,6 @@ class Phase;
 
 class Job;
 
-enum NodeType {
-	COMPUTE_NODE = 0,
-	COMPUTE_NODE_WITH_BB = 1,
-	COMPUTE_NODE_WITH_WIDE_STRIPED_BB = 2,
-};
-
 enum NodeState {
 	NODE_FREE = 0,
 	NODE_ALLOCATED = 1,
@@ -40,10 +35,9 @@ class Node {
 
 private:
 	const int id;
-	const NodeType type;
+	const NodeClass* nodeClass;
 	s4u_Host* host;
 	s4u_Disk* nodeLocalBurstBuffer;
-	std::vector<s4u_Host*> pfsHosts;
 	NodeState state;
 	std::set<Job*> runningJobs;
 	std::unordered_map<Job*, int> assignedRank;
@@ -55,10 +49,15 @@ private:
 	std::unordered_map<Job*, bool> initializing;
 	std::unordered_map<Job*, bool> reconfiguring;
 	std::unordered_map<Job*, bool> expanding;
-	const double flopsPerByte;
+	std::unordered_map<Job*, bool> restarting;
+	std::unordered_map<Job*, bool> suspended;
+	std::unordered_map<Job*, bool> exited;
+	std::unordered_map<const Job*, std::pair<int, int>> progress;
+	// activities and helper actors a job runs next to its application actor, suspended and resumed along with it
+	mutable std::unordered_map<const Job*, std::vector<simgrid::s4u::ActivityPtr>> trackedActivities;
+	mutable std::unordered_map<const Job*, std::vector<aid_t>> helperActors;
 	std::vector<std::unique_ptr<Gpu>> gpus;
 	std::vector<const Gpu*> gpuPointers;
-	const long gpuToGpuBandwidth;
 	simgrid::s4u::MutexPtr gpuLinkMutex;
 	std::set<Job*> expectedJobs;
 	const bool allowOversubscription;
@@ -67,12 +66,17 @@ private:
 
 	void collectStatistics();
 
+	void releaseJob(Job* job);
+
+	void trackHelperActor(const Job* job, aid_t pid) const;
+
+	void launchApplication(Job* job);
+
 public:
-	Node(int id, NodeType type, s4u_Host* host, s4u_Disk* nodeLocalBurstBuffer, std::vector<s4u_Host*> pfsHosts,
-		 double flopsPerByte, std::vector<std::unique_ptr<Gpu>> gpus, long gpuToGpuBandwidth,
-		 std::ofstream& nodeUtilizationOutput, std::ofstream& taskTimes);
+	Node(int id, const NodeClass* nodeClass, s4u_Host* host, std::ofstream& nodeUtilizationOutput,
+		 std::ofstream& taskTimes);
 
-	void allocateJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBarrier);
+	void allocateJob(Job* job, int rank, const simgrid::s4u::BarrierPtr& jobBarrier, bool restart = false);
 
 	void continueJob(Job* job);
 
@@ -85,10 +89,20 @@ public:
 
 	void killJob(Job* job);
 
+	void suspendJob(Job* job);
+
+	void resumeJob(Job* job);
+
 	[[nodiscard]] int getId() const;
 
+	[[nodiscard]] const NodeClass* getNodeClass() const;
+
 	[[nodiscard]] NodeType getType() const;
 
+	[[nodiscard]] NodeState getState() const;
+
+	[[nodiscard]] const std::set<Job*>& getRunningJobs() const;
+
 	[[nodiscard]] s4u_Host* getHost() const;
 
 	[[nodiscard]] std::string getHostName() const;
@@ -103,13 +117,22 @@ public:
 
 	[[nodiscard]] long getGpuToGpuBandwidth() const;
 
-	[[nodiscard]] std::vector<s4u_Mailbox*> execGpuComputationAsync(int numGpus, double flopsPerGpu) const;
+	[[nodiscard]] std::vector<s4u_Mailbox*>
+	execGpuComputationAsync(const Job* job, int numGpus, double flopsPerGpu) const;
 
 	void occupyGpuLink() const;
 
 	void releaseGpuLink() const;
 
-	[[nodiscard]] s4u_Mailbox* execGpuTransferAsync(const std::vector<double>& bytes, int numGpus) const;
+	[[nodiscard]] static double getDominantGpuTransfer(const std::vector<double>& bytes, int numGpus);
+
+	[[nodiscard]] s4u_Mailbox*
+	execGpuTransferAsync(const Job* job, const std::vector<double>& bytes, int numGpus) const;
+
+	[[nodiscard]] s4u_Mailbox* execGpuTransferAsync(const Job* job, double bytes) const;
+
+	[[nodiscard]] std::vector<simgrid::s4u::ActivityPtr>
+	trackActivities(const Job* job, std::vector<simgrid::s4u::ActivityPtr> activities) const;
 
 	[[nodiscard]] const simgrid::s4u::BarrierPtr& getBarrier(Job* job) const;
 
@@ -127,12 +150,28 @@ public:
 
 	void markExpanded(Job* job);
 
+	[[nodiscard]] bool isRestarting(Job* job) const;
+
+	void markRestarted(Job* job);
+
+	[[nodiscard]] bool hasExited(Job* job) const;
+
+	void markExited(Job* job);
+
+	void recordProgress(const Job* job, int completedPhases, int remainingIterations);
+
+	[[nodiscard]] std::pair<int, int> getProgress(const Job* job) const;
+
+	void clearProgress(const Job* job);
+
 	[[nodiscard]] int getExpandRank(Job* job) const;
 
 	void expectJob(Job* job);
 
 	void removeExpectedJob(Job* job);
 
+	[[nodiscard]] bool isExpecting(Job* job) const;
+
 	void logTaskTime(const Job* job, const Task* task, double duration) const;
 
 	[[nodiscard]] nlohmann::json toJson();
@@ -0,0 +1,186 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "NodeAllocator.h"
+
+#include <algorithm>
+#include <xbt/asserts.h>
+#include "Node.h"
+#include "Job.h"
+#include "PlatformManager.h"
+#include "Configuration.h"
+
+bool NodeAllocator::enabled = false;
+bool NodeAllocator::compact = false;
+std::vector<std::string> NodeAllocator::classNames;
+std::vector<int> NodeAllocator::nodeClasses;
+std::vector<std::set<int>> NodeAllocator::freeNodes;
+std::vector<int> NodeAllocator::numNodes;
+std::vector<int> NodeAllocator::numAllocatedNodes;
+std::vector<bool> NodeAllocator::allocated;
+std::unordered_map<int, NodeSet> NodeAllocator::claims;
+
+std::vector<int> NodeAllocator::take(int nodeClass, int count) {
+	std::set<int>& free = freeNodes[nodeClass];
+	if ((size_t) count > free.size()) {
+		xbt_die("%d nodes of class %s requested but only %zu are free", count, classNames[nodeClass].c_str(),
+				free.size());
+	}
+	auto first = free.begin();
+	if (compact && count > 1) {
+		// first run of consecutive node IDs long enough for the request, falls back to the lowest IDs otherwise
+		auto runStart = free.begin();
+		int runLength = 0;
+		int previous = -2;
+		for (auto it = free.begin(); it != free.end(); ++it) {
+			if (*it != previous + 1) {
+				runStart = it;
+				runLength = 0;
+			}
+			previous = *it;
+			if (++runLength == count) {
+				first = runStart;
+				break;
+			}
+		}
+	}
+	auto last = std::next(first, count);
+	std::vector<int> ids(first, last);
+	free.erase(first, last);
+	return ids;
+}
+
+void NodeAllocator::init() {
+	enabled = Configuration::getBoolIfExists("count_based_allocation");
+	if (!enabled) {
+		return;
+	}
+	compact = Configuration::getBoolIfExists("compact_allocation");
+	const std::vector<std::unique_ptr<NodeClass>>& classes = PlatformManager::getNodeClasses();
+	const std::vector<Node*>& nodes = PlatformManager::getComputeNodes();
+	classNames.reserve(classes.size());
+	for (const auto& nodeClass: classes) {
+		classNames.push_back(nodeClass->getName());
+	}
+	freeNodes.resize(classes.size());
+	numNodes.resize(classes.size());
+	numAllocatedNodes.resize(classes.size());
+	nodeClasses.resize(nodes.size());
+	allocated.resize(nodes.size());
+	for (const auto& node: nodes) {
+		int nodeClass = node->getNodeClass()->getId();
+		nodeClasses[node->getId()] = nodeClass;
+		freeNodes[nodeClass].insert(freeNodes[nodeClass].end(), node->getId());
+		++numNodes[nodeClass];
+	}
+}
+
+bool NodeAllocator::isEnabled() {
+	return enabled;
+}
+
+nlohmann::json NodeAllocator::countNodes(const std::vector<Node*>& nodes) {
+	std::vector<int> counts(classNames.size());
+	for (const auto& node: nodes) {
+		++counts[nodeClasses[node->getId()]];
+	}
+	nlohmann::json json = nlohmann::json::object();
+	for (size_t i = 0; i < counts.size(); ++i) {
+		if (counts[i] > 0) {
+			json[classNames[i]] = counts[i];
+		}
+	}
+	return json;
+}
+
+std::vector<Node*> NodeAllocator::allocate(const Job* job, const nlohmann::json& counts) {
+	std::vector<int> requested(classNames.size());
+	int total = 0;
+	for (const auto& [name, count]: counts.items()) {
+		auto it = std::find(classNames.begin(), classNames.end(), name);
+		if (it == classNames.end()) {
+			xbt_die("Unknown node class %s requested for job %d", name.c_str(), job->getId());
+		}
+		requested[it - classNames.begin()] = count;
+		total += (int) count;
+	}
+
+	// nodes already assigned are kept in their order to preserve ranks, shrinking drops the last ones per class
+	std::vector<Node*> nodes;
+	nodes.reserve(total);
+	std::vector<int> kept(classNames.size());
+	for (const auto& node: job->getAssignedNodes()) {
+		int nodeClass = nodeClasses[node->getId()];
+		if (kept[nodeClass] < requested[nodeClass]) {
+			nodes.push_back(node);
+			++kept[nodeClass];
+		}
+	}
+	const std::vector<Node*>& computeNodes = PlatformManager::getComputeNodes();
+	NodeSet& claim = claims[job->getId()];
+	for (size_t nodeClass = 0; nodeClass < classNames.size(); ++nodeClass) {
+		if (requested[nodeClass] > kept[nodeClass]) {
+			for (int id: take((int) nodeClass, requested[nodeClass] - kept[nodeClass])) {
+				nodes.push_back(computeNodes[id]);
+				claim.insert(computeNodes[id]);
+			}
+		}
+	}
+	return nodes;
+}
+
+void NodeAllocator::claim(const Job* job, const std::vector<Node*>& nodes) {
+	NodeSet& claim = claims[job->getId()];
+	for (const auto& node: nodes) {
+		if (freeNodes[nodeClasses[node->getId()]].erase(node->getId())) {
+			claim.insert(node);
+		} else if (!claim.contains(node)) {
+			xbt_die("Node %d is not free and can not be assigned to job %d", node->getId(), job->getId());
+		}
+	}
+}
+
+void NodeAllocator::reconcile(const Job* job) {
+	auto it = claims.find(job->getId());
+	if (it == claims.end()) {
+		return;
+	}
+	NodeSet held;
+	if (job->getState() != COMPLETED && job->getState() != KILLED) {
+		held = job->getAssignedNodeSet() | job->getExecutingNodeSet();
+	}
+	for (const auto& node: (it->second - held).resolve(PlatformManager::getComputeNodes())) {
+		freeNodes[nodeClasses[node->getId()]].insert(node->getId());
+	}
+	if (held.empty()) {
+		claims.erase(it);
+	} else {
+		it->second = it->second & held;
+	}
+}
+
+void NodeAllocator::updateNodeState(const Node* node) {
+	bool isAllocated = node->getState() == NODE_ALLOCATED;
+	if (allocated[node->getId()] != isAllocated) {
+		allocated[node->getId()] = isAllocated;
+		numAllocatedNodes[nodeClasses[node->getId()]] += isAllocated ? 1 : -1;
+	}
+}
+
+nlohmann::json NodeAllocator::toJson() {
+	nlohmann::json json = nlohmann::json::array();
+	for (size_t i = 0; i < classNames.size(); ++i) {
+		int numFreeNodes = (int) freeNodes[i].size();
+		json.push_back({{"name", classNames[i]}, {"num_nodes", numNodes[i]}, {"free", numFreeNodes},
+						{"reserved", std::max(0, numNodes[i] - numFreeNodes - numAllocatedNodes[i])},
+						{"allocated", numAllocatedNodes[i]}});
+	}
+	return json;
+}
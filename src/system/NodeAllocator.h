@@ -0,0 +1,64 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_NODEALLOCATOR_H
+#define ELASTISIM_NODEALLOCATOR_H
+
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+#include "NodeSet.h"
+
+class Node;
+
+class Job;
+
+// Picks concrete compute nodes for count-based scheduling decisions. Nodes are grouped into classes, each with a
+// free list ordered by node ID. A node leaves the free list once it is assigned to a job and returns as soon as the
+// job neither has it assigned nor executes on it anymore.
+class NodeAllocator {
+
+private:
+	static bool enabled;
+	static bool compact;
+	static std::vector<std::string> classNames;
+	static std::vector<int> nodeClasses;
+	static std::vector<std::set<int>> freeNodes;
+	static std::vector<int> numNodes;
+	static std::vector<int> numAllocatedNodes;
+	static std::vector<bool> allocated;
+	static std::unordered_map<int, NodeSet> claims;
+
+	[[nodiscard]] static std::vector<int> take(int nodeClass, int count);
+
+public:
+	static void init();
+
+	[[nodiscard]] static bool isEnabled();
+
+	[[nodiscard]] static nlohmann::json countNodes(const std::vector<Node*>& nodes);
+
+	[[nodiscard]] static std::vector<Node*> allocate(const Job* job, const nlohmann::json& counts);
+
+	static void claim(const Job* job, const std::vector<Node*>& nodes);
+
+	static void reconcile(const Job* job);
+
+	static void updateNodeState(const Node* node);
+
+	[[nodiscard]] static nlohmann::json toJson();
+
+};
+
+
+#endif //ELASTISIM_NODEALLOCATOR_H
@@ -0,0 +1,163 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "NodeClass.h"
+
+#include <sstream>
+#include <utility>
+#include <xbt/asserts.h>
+#include <xbt/parse_units.hpp>
+
+const char* const NodeClass::properties[] = {"num_gpus", "flops_per_gpu", "gpu_to_gpu_bw", "node_local_bb",
+											 "bb_read_bw", "bb_write_bw", "wide_striping", "flops_per_byte",
+											 "pfs_targets"};
+
+NodeClass::NodeClass(int id, std::string name, NodeType type, std::vector<s4u_Host*> pfsHosts, int numGpus,
+					 long flopsPerGpu, long gpuToGpuBandwidth, double burstBufferReadBandwidth,
+					 double burstBufferWriteBandwidth, double flopsPerByte) :
+		id(id), name(std::move(name)), type(type), pfsHosts(std::move(pfsHosts)), numGpus(numGpus),
+		flopsPerGpu(flopsPerGpu), gpuToGpuBandwidth(gpuToGpuBandwidth),
+		burstBufferReadBandwidth(burstBufferReadBandwidth), burstBufferWriteBandwidth(burstBufferWriteBandwidth),
+		flopsPerByte(flopsPerByte) {}
+
+std::string NodeClass::describe(const s4u_Host* host) {
+	// missing properties and empty values must not collide, hence the distinct markers
+	std::string description;
+	for (const char* property: properties) {
+		const char* value = host->get_property(property);
+		if (value) {
+			description += '=';
+			description += value;
+		}
+		description += '\x1f';
+	}
+	return description;
+}
+
+std::unique_ptr<NodeClass>
+NodeClass::fromHost(int id, const s4u_Host* host, const std::vector<s4u_Host*>& defaultPfsHosts,
+					const std::unordered_set<std::string>& existingNames) {
+
+	std::vector<s4u_Host*> pfsTargets;
+	if (host->get_property("pfs_targets")) {
+		simgrid::s4u::Engine* engine = simgrid::s4u::Engine::get_instance();
+		std::stringstream stream(host->get_property("pfs_targets"));
+		while (stream.good()) {
+			std::string pfsHostname;
+			getline(stream, pfsHostname, ',');
+			pfsTargets.push_back(engine->host_by_name(pfsHostname));
+		}
+	} else {
+		pfsTargets = defaultPfsHosts;
+	}
+
+	int numGpus = 0;
+	long flopsPerGpu = 0;
+	long gpuToGpuBandwidth = 0;
+	if (host->get_property("num_gpus")) {
+		numGpus = std::stoi(host->get_property("num_gpus"));
+		flopsPerGpu = (long) xbt_parse_get_speed("", 0, host->get_property("flops_per_gpu"), "");
+		if (numGpus > 1) {
+			gpuToGpuBandwidth = (long) xbt_parse_get_bandwidth("", 0, host->get_property("gpu_to_gpu_bw"), "");
+		}
+	}
+
+	NodeType type = COMPUTE_NODE;
+	double burstBufferReadBandwidth = 0;
+	double burstBufferWriteBandwidth = 0;
+	double flopsPerByte = 0;
+	const char* nodeLocalBurstBuffer = host->get_property("node_local_bb");
+	if (nodeLocalBurstBuffer && std::string(nodeLocalBurstBuffer) == "true") {
+		type = COMPUTE_NODE_WITH_BB;
+		burstBufferReadBandwidth = xbt_parse_get_bandwidth("", 0, host->get_property("bb_read_bw"), "");
+		burstBufferWriteBandwidth = xbt_parse_get_bandwidth("", 0, host->get_property("bb_write_bw"), "");
+		const char* wideStriping = host->get_property("wide_striping");
+		if (wideStriping && std::string(wideStriping) == "true") {
+			type = COMPUTE_NODE_WITH_WIDE_STRIPED_BB;
+			if (host->get_property("flops_per_byte")) {
+				flopsPerByte = xbt_parse_get_speed("", 0, host->get_property("flops_per_byte"), "");
+			}
+		}
+	}
+
+	std::string name;
+	if (const char* declaredName = host->get_property("node_class")) {
+		name = declaredName;
+		if (existingNames.count(name)) {
+			xbt_die("Node class %s collides with a node class detected from host properties", declaredName);
+		}
+	} else {
+		switch (type) {
+			case COMPUTE_NODE_WITH_BB:
+				name = "compute_bb";
+				break;
+			case COMPUTE_NODE_WITH_WIDE_STRIPED_BB:
+				name = "compute_wide_striped_bb";
+				break;
+			default:
+				name = "compute";
+		}
+		if (numGpus > 0) {
+			name += "_" + std::to_string(numGpus) + "gpu";
+		}
+		// classes differing only in bandwidths or PFS targets are told apart by their ID
+		if (existingNames.count(name)) {
+			name += "_" + std::to_string(id);
+		}
+	}
+
+	return std::make_unique<NodeClass>(id, std::move(name), type, std::move(pfsTargets), numGpus, flopsPerGpu,
+									   gpuToGpuBandwidth, burstBufferReadBandwidth, burstBufferWriteBandwidth,
+									   flopsPerByte);
+}
+
+int NodeClass::getId() const {
+	return id;
+}
+
+const std::string& NodeClass::getName() const {
+	return name;
+}
+
+NodeType NodeClass::getType() const {
+	return type;
+}
+
+const std::vector<s4u_Host*>& NodeClass::getPfsHosts() const {
+	return pfsHosts;
+}
+
+int NodeClass::getNumGpus() const {
+	return numGpus;
+}
+
+long NodeClass::getFlopsPerGpu() const {
+	return flopsPerGpu;
+}
+
+long NodeClass::getGpuToGpuBandwidth() const {
+	return gpuToGpuBandwidth;
+}
+
+bool NodeClass::hasNodeLocalBurstBuffer() const {
+	return type != COMPUTE_NODE;
+}
+
+double NodeClass::getBurstBufferReadBandwidth() const {
+	return burstBufferReadBandwidth;
+}
+
+double NodeClass::getBurstBufferWriteBandwidth() const {
+	return burstBufferWriteBandwidth;
+}
+
+double NodeClass::getFlopsPerByte() const {
+	return flopsPerByte;
+}
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_NODECLASS_H
+#define ELASTISIM_NODECLASS_H
+
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <simgrid/s4u.hpp>
+
+enum NodeType {
+	COMPUTE_NODE = 0,
+	COMPUTE_NODE_WITH_BB = 1,
+	COMPUTE_NODE_WITH_WIDE_STRIPED_BB = 2,
+};
+
+// Immutable hardware description shared by all compute nodes with identical host properties. Hosts either declare
+// their class through the node_class property, in which case the properties of the first such host apply to all of
+// them, or are grouped automatically by the raw values of the properties below.
+class NodeClass {
+
+private:
+	static const char* const properties[];
+
+	const int id;
+	const std::string name;
+	const NodeType type;
+	const std::vector<s4u_Host*> pfsHosts;
+	const int numGpus;
+	const long flopsPerGpu;
+	const long gpuToGpuBandwidth;
+	const double burstBufferReadBandwidth;
+	const double burstBufferWriteBandwidth;
+	const double flopsPerByte;
+
+public:
+	NodeClass(int id, std::string name, NodeType type, std::vector<s4u_Host*> pfsHosts, int numGpus,
+			  long flopsPerGpu, long gpuToGpuBandwidth, double burstBufferReadBandwidth,
+			  double burstBufferWriteBandwidth, double flopsPerByte);
+
+	[[nodiscard]] static std::string describe(const s4u_Host* host);
+
+	[[nodiscard]] static std::unique_ptr<NodeClass>
+	fromHost(int id, const s4u_Host* host, const std::vector<s4u_Host*>& defaultPfsHosts,
+			 const std::unordered_set<std::string>& existingNames);
+
+	[[nodiscard]] int getId() const;
+
+	[[nodiscard]] const std::string& getName() const;
+
+	[[nodiscard]] NodeType getType() const;
+
+	[[nodiscard]] const std::vector<s4u_Host*>& getPfsHosts() const;
+
+	[[nodiscard]] int getNumGpus() const;
+
+	[[nodiscard]] long getFlopsPerGpu() const;
+
+	[[nodiscard]] long getGpuToGpuBandwidth() const;
+
+	[[nodiscard]] bool hasNodeLocalBurstBuffer() const;
+
+	[[nodiscard]] double getBurstBufferReadBandwidth() const;
+
+	[[nodiscard]] double getBurstBufferWriteBandwidth() const;
+
+	[[nodiscard]] double getFlopsPerByte() const;
+
+};
+
+
+#endif //ELASTISIM_NODECLASS_H
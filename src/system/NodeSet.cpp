@@ -0,0 +1,129 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "NodeSet.h"
+
+#include <algorithm>
+#include "Node.h"
+
+#define WORD_BITS 64
+
+NodeSet::NodeSet() = default;
+
+NodeSet::NodeSet(const std::vector<Node*>& nodes) {
+	for (const auto& node: nodes) {
+		insert(node);
+	}
+}
+
+void NodeSet::reserveFor(int id) {
+	size_t requiredWords = id / WORD_BITS + 1;
+	if (words.size() < requiredWords) {
+		words.resize(requiredWords, 0);
+	}
+}
+
+void NodeSet::insert(const Node* node) {
+	int id = node->getId();
+	reserveFor(id);
+	words[id / WORD_BITS] |= uint64_t(1) << (id % WORD_BITS);
+}
+
+void NodeSet::erase(const Node* node) {
+	int id = node->getId();
+	if (id >= 0 && (size_t) id / WORD_BITS < words.size()) {
+		words[id / WORD_BITS] &= ~(uint64_t(1) << (id % WORD_BITS));
+	}
+}
+
+void NodeSet::clear() {
+	words.clear();
+}
+
+bool NodeSet::contains(const Node* node) const {
+	int id = node->getId();
+	return id >= 0 && (size_t) id / WORD_BITS < words.size() && (words[id / WORD_BITS] >> (id % WORD_BITS)) & 1;
+}
+
+size_t NodeSet::size() const {
+	size_t count = 0;
+	for (const auto& word: words) {
+		count += __builtin_popcountll(word);
+	}
+	return count;
+}
+
+bool NodeSet::empty() const {
+	for (const auto& word: words) {
+		if (word) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<Node*> NodeSet::resolve(const std::vector<Node*>& nodes) const {
+	std::vector<Node*> resolvedNodes;
+	for (size_t i = 0; i < words.size(); ++i) {
+		uint64_t word = words[i];
+		while (word) {
+			resolvedNodes.push_back(nodes[i * WORD_BITS + __builtin_ctzll(word)]);
+			word &= word - 1;
+		}
+	}
+	return resolvedNodes;
+}
+
+NodeSet NodeSet::operator&(const NodeSet& other) const {
+	NodeSet result;
+	result.words.resize(std::min(words.size(), other.words.size()));
+	for (size_t i = 0; i < result.words.size(); ++i) {
+		result.words[i] = words[i] & other.words[i];
+	}
+	return result;
+}
+
+NodeSet NodeSet::operator|(const NodeSet& other) const {
+	NodeSet result = words.size() >= other.words.size() ? *this : other;
+	const NodeSet& smaller = words.size() >= other.words.size() ? other : *this;
+	for (size_t i = 0; i < smaller.words.size(); ++i) {
+		result.words[i] |= smaller.words[i];
+	}
+	return result;
+}
+
+NodeSet NodeSet::operator-(const NodeSet& other) const {
+	NodeSet result = *this;
+	size_t commonWords = std::min(words.size(), other.words.size());
+	for (size_t i = 0; i < commonWords; ++i) {
+		result.words[i] &= ~other.words[i];
+	}
+	return result;
+}
+
+bool NodeSet::operator==(const NodeSet& other) const {
+	const NodeSet& larger = words.size() >= other.words.size() ? *this : other;
+	size_t commonWords = std::min(words.size(), other.words.size());
+	for (size_t i = 0; i < commonWords; ++i) {
+		if (words[i] != other.words[i]) {
+			return false;
+		}
+	}
+	for (size_t i = commonWords; i < larger.words.size(); ++i) {
+		if (larger.words[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool NodeSet::operator!=(const NodeSet& other) const {
+	return !(*this == other);
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_NODESET_H
+#define ELASTISIM_NODESET_H
+
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class Node;
+
+class NodeSet {
+
+private:
+	std::vector<uint64_t> words;
+
+	void reserveFor(int id);
+
+public:
+	NodeSet();
+
+	explicit NodeSet(const std::vector<Node*>& nodes);
+
+	void insert(const Node* node);
+
+	void erase(const Node* node);
+
+	void clear();
+
+	[[nodiscard]] bool contains(const Node* node) const;
+
+	[[nodiscard]] size_t size() const;
+
+	[[nodiscard]] bool empty() const;
+
+	[[nodiscard]] std::vector<Node*> resolve(const std::vector<Node*>& nodes) const;
+
+	[[nodiscard]] NodeSet operator&(const NodeSet& other) const;
+
+	[[nodiscard]] NodeSet operator|(const NodeSet& other) const;
+
+	[[nodiscard]] NodeSet operator-(const NodeSet& other) const;
+
+	[[nodiscard]] bool operator==(const NodeSet& other) const;
+
+	[[nodiscard]] bool operator!=(const NodeSet& other) const;
+
+};
+
+
+#endif //ELASTISIM_NODESET_H
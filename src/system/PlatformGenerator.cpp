@@ -0,0 +1,193 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "PlatformGenerator.h"
+
+#include <functional>
+#include <xbt/asserts.h>
+#include <xbt/log.h>
+#include <xbt/parse_units.hpp>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(PlatformGenerator, "Messages within the PlatformGenerator");
+
+namespace sg4 = simgrid::s4u;
+
+std::vector<std::string> PlatformGenerator::pfsReadLinks;
+std::vector<std::string> PlatformGenerator::pfsWriteLinks;
+
+double PlatformGenerator::getSpeed(const nlohmann::json& value) {
+	if (value.is_number()) {
+		return value;
+	}
+	return xbt_parse_get_speed("", 0, value.get<std::string>(), "");
+}
+
+double PlatformGenerator::getBandwidth(const nlohmann::json& value) {
+	if (value.is_number()) {
+		return value;
+	}
+	return xbt_parse_get_bandwidth("", 0, value.get<std::string>(), "");
+}
+
+double PlatformGenerator::getTime(const nlohmann::json& value) {
+	if (value.is_number()) {
+		return value;
+	}
+	return xbt_parse_get_time("", 0, value.get<std::string>(), "");
+}
+
+sg4::Link::SharingPolicy PlatformGenerator::getSharingPolicy(const std::string& policy) {
+	if (policy == "split_duplex") {
+		return sg4::Link::SharingPolicy::SPLITDUPLEX;
+	} else if (policy == "shared") {
+		return sg4::Link::SharingPolicy::SHARED;
+	} else if (policy == "fatpipe") {
+		return sg4::Link::SharingPolicy::FATPIPE;
+	} else {
+		xbt_die("Unknown sharing policy %s", policy.c_str());
+	}
+}
+
+std::vector<unsigned int>
+PlatformGenerator::getCounts(const nlohmann::json& description, const std::string& key, unsigned int levels) {
+	if (!description.contains(key)) {
+		xbt_die("Fat tree description misses %s", key.c_str());
+	}
+	std::vector<unsigned int> counts = description[key];
+	if (counts.size() != levels) {
+		xbt_die("Fat tree %s has to list one entry per level (%u expected, %zu given)", key.c_str(), levels,
+				counts.size());
+	}
+	return counts;
+}
+
+std::pair<unsigned int, unsigned int>
+PlatformGenerator::getDragonflyLevel(const nlohmann::json& description, const std::string& key) {
+	if (!description.contains(key) || !description[key].is_array() || description[key].size() != 2) {
+		xbt_die("Dragonfly %s has to be given as [count, links]", key.c_str());
+	}
+	return {description[key][0], description[key][1]};
+}
+
+s4u_NetZone* PlatformGenerator::createComputeZone(const nlohmann::json& description, const s4u_NetZone* parent) {
+	std::string prefix = description.value("host_prefix", "node");
+	double speed = getSpeed(description.value("speed", nlohmann::json("1Gf")));
+	int cores = description.value("cores", 1);
+	double bandwidth = getBandwidth(description.value("bandwidth", nlohmann::json("10GBps")));
+	double latency = getTime(description.value("latency", nlohmann::json("1us")));
+	sg4::Link::SharingPolicy sharingPolicy = getSharingPolicy(description.value("sharing_policy", "split_duplex"));
+	std::unordered_map<std::string, std::string> properties;
+	if (description.contains("host_properties")) {
+		for (const auto& [property, value]: description["host_properties"].items()) {
+			properties[property] = value.is_string() ? value.get<std::string>() : value.dump();
+		}
+	}
+
+	std::function<sg4::ClusterCallbacks::ClusterHostCb> createHost =
+			[prefix, speed, cores, &properties](sg4::NetZone* zone, const std::vector<unsigned long>& /*coordinates*/,
+												unsigned long id) {
+				return zone->create_host(prefix + std::to_string(id), speed)->set_core_count(cores)
+						->set_properties(properties)->seal();
+			};
+	std::function<sg4::ClusterCallbacks::ClusterLinkCb> createLoopback;
+	if (description.contains("loopback")) {
+		double loopbackBandwidth = getBandwidth(description["loopback"].at("bandwidth"));
+		double loopbackLatency = getTime(description["loopback"].value("latency", nlohmann::json(0)));
+		createLoopback = [prefix, loopbackBandwidth, loopbackLatency](sg4::NetZone* zone,
+																	  const std::vector<unsigned long>& /*coordinates*/,
+																	  unsigned long id) {
+			return zone->create_link(prefix + std::to_string(id) + "_loopback", loopbackBandwidth)
+					->set_latency(loopbackLatency)->set_sharing_policy(sg4::Link::SharingPolicy::FATPIPE)->seal();
+		};
+	}
+	sg4::ClusterCallbacks callbacks(createHost, createLoopback, {});
+
+	const std::string& generator = description["generator"];
+	s4u_NetZone* zone;
+	if (generator == "fat_tree") {
+		if (!description.contains("fat_tree")) {
+			xbt_die("Fat tree platforms require a fat_tree description");
+		}
+		const nlohmann::json& tree = description["fat_tree"];
+		unsigned int levels = tree.at("levels");
+		sg4::FatTreeParams parameters(levels, getCounts(tree, "down_links", levels),
+									  getCounts(tree, "up_links", levels), getCounts(tree, "link_counts", levels));
+		zone = sg4::create_fatTree_zone("compute", parent, parameters, callbacks, bandwidth, latency, sharingPolicy);
+	} else if (generator == "dragonfly") {
+		if (!description.contains("dragonfly")) {
+			xbt_die("Dragonfly platforms require a dragonfly description");
+		}
+		const nlohmann::json& dragonfly = description["dragonfly"];
+		sg4::DragonflyParams parameters(getDragonflyLevel(dragonfly, "groups"), getDragonflyLevel(dragonfly, "chassis"),
+										getDragonflyLevel(dragonfly, "routers"), dragonfly.at("nodes"));
+		zone = sg4::create_dragonfly_zone("compute", parent, parameters, callbacks, bandwidth, latency, sharingPolicy);
+	} else {
+		xbt_die("Unknown platform generator %s", generator.c_str());
+	}
+	zone->set_gateway(zone->create_router(prefix + "_router"));
+	zone->seal();
+	return zone;
+}
+
+s4u_NetZone* PlatformGenerator::createServiceZone(const nlohmann::json& description, const s4u_NetZone* parent) {
+	s4u_NetZone* zone = sg4::create_star_zone("service")->set_parent(parent);
+	double speed = getSpeed(description.value("service_speed", nlohmann::json("1Gf")));
+	double latency = getTime(description.value("service_latency", nlohmann::json("1us")));
+
+	s4u_Host* master = zone->create_host("master", speed)->set_property("batch_system", "true")->seal();
+	const s4u_Link* masterLink = zone->create_split_duplex_link(
+			"master_link", getBandwidth(description.value("master_bandwidth", nlohmann::json("10GBps"))))
+			->set_latency(latency)->seal();
+	zone->add_route(master->get_netpoint(), nullptr, nullptr, nullptr,
+					{{masterLink, sg4::LinkInRoute::Direction::UP}}, true);
+
+	int numPfsHosts = description.value("num_pfs_hosts", 1);
+	double pfsBandwidth = getBandwidth(description.value("pfs_bandwidth", nlohmann::json("100GBps")));
+	for (int i = 0; i < numPfsHosts; ++i) {
+		std::string name = "pfs" + std::to_string(i);
+		s4u_Host* pfs = zone->create_host(name, speed)->set_property("pfs_host", "true")->seal();
+		const s4u_Link* link = zone->create_split_duplex_link(name + "_link", pfsBandwidth)->set_latency(latency)
+				->seal();
+		zone->add_route(pfs->get_netpoint(), nullptr, nullptr, nullptr, {{link, sg4::LinkInRoute::Direction::UP}},
+						true);
+		// reads flow from the PFS host towards the compute nodes, writes the other way around
+		pfsReadLinks.push_back(name + "_link_UP");
+		pfsWriteLinks.push_back(name + "_link_DOWN");
+	}
+
+	zone->set_gateway(zone->create_router("service_router"));
+	zone->seal();
+	return zone;
+}
+
+void PlatformGenerator::generate(const nlohmann::json& description) {
+	if (!description.contains("generator")) {
+		xbt_die("Platform description misses the generator");
+	}
+	s4u_NetZone* world = sg4::create_full_zone("world");
+	s4u_NetZone* compute = createComputeZone(description, world);
+	s4u_NetZone* service = createServiceZone(description, world);
+
+	const s4u_Link* backbone = world->create_link(
+			"backbone", getBandwidth(description.value("backbone_bandwidth", nlohmann::json("200GBps"))))
+			->set_latency(getTime(description.value("backbone_latency", nlohmann::json("1us"))))->seal();
+	world->add_route(compute->get_netpoint(), service->get_netpoint(), compute->get_gateway(), service->get_gateway(),
+					 {backbone}, true);
+	world->seal();
+	XBT_INFO("Generated %s platform", description["generator"].get<std::string>().c_str());
+}
+
+const std::vector<std::string>& PlatformGenerator::getPfsReadLinks() {
+	return pfsReadLinks;
+}
+
+const std::vector<std::string>& PlatformGenerator::getPfsWriteLinks() {
+	return pfsWriteLinks;
+}
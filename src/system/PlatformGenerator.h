@@ -0,0 +1,59 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_PLATFORMGENERATOR_H
+#define ELASTISIM_PLATFORMGENERATOR_H
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <json.hpp>
+#include <simgrid/s4u.hpp>
+
+// Builds fat-tree and dragonfly platforms through the s4u API instead of parsing a platform file. The compute zone
+// is connected via a backbone link to a service zone holding the batch system host and the PFS hosts, each attached
+// with a split-duplex link named pfs<i>_link. Compute hosts receive the configured host properties, node-local burst
+// buffers are thus created from the node_local_bb properties like for platform files.
+class PlatformGenerator {
+
+private:
+	static std::vector<std::string> pfsReadLinks;
+	static std::vector<std::string> pfsWriteLinks;
+
+	[[nodiscard]] static double getSpeed(const nlohmann::json& value);
+
+	[[nodiscard]] static double getBandwidth(const nlohmann::json& value);
+
+	[[nodiscard]] static double getTime(const nlohmann::json& value);
+
+	[[nodiscard]] static simgrid::s4u::Link::SharingPolicy getSharingPolicy(const std::string& policy);
+
+	[[nodiscard]] static std::vector<unsigned int> getCounts(const nlohmann::json& description, const std::string& key,
+															 unsigned int levels);
+
+	[[nodiscard]] static std::pair<unsigned int, unsigned int> getDragonflyLevel(const nlohmann::json& description,
+																				 const std::string& key);
+
+	static s4u_NetZone* createComputeZone(const nlohmann::json& description, const s4u_NetZone* parent);
+
+	static s4u_NetZone* createServiceZone(const nlohmann::json& description, const s4u_NetZone* parent);
+
+public:
+	static void generate(const nlohmann::json& description);
+
+	[[nodiscard]] static const std::vector<std::string>& getPfsReadLinks();
+
+	[[nodiscard]] static const std::vector<std::string>& getPfsWriteLinks();
+
+};
+
+
+#endif //ELASTISIM_PLATFORMGENERATOR_H
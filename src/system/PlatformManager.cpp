@@ -13,13 +13,22 @@
 #include <utility>
 #include <xbt/asserts.h>
 #include "Node.h"
+#include "NodeClass.h"
+#include "Job.h"
+#include "Workload.h"
+#include "Phase.h"
+#include "Task.h"
 #include "Configuration.h"
+#include "PlatformGenerator.h"
 
+std::vector<std::unique_ptr<NodeClass>> PlatformManager::nodeClasses;
 std::vector<std::unique_ptr<Node>> PlatformManager::nodes;
 std::vector<Node*> PlatformManager::computeNodes;
 std::vector<Node*> PlatformManager::modifiedComputeNodes;
+std::unordered_set<Node*> PlatformManager::modifiedComputeNodesSet;
 std::vector<Job*> PlatformManager::modifiedJobs;
 std::unordered_set<Job*> PlatformManager::modifiedJobsSet;
+std::vector<std::unique_ptr<Job>> PlatformManager::releasedJobs;
 std::vector<s4u_Link*> PlatformManager::pfsReadLinks;
 std::vector<s4u_Link*> PlatformManager::pfsWriteLinks;
 double PlatformManager::pfsReadBandwidth = 0;
@@ -27,21 +36,37 @@ double PlatformManager::pfsWriteBandwidth = 0;
 
 bool PlatformManager::initialized = false;
 
-void PlatformManager::init(std::vector<std::unique_ptr<Node>> initialNodes) {
+void PlatformManager::init(std::vector<std::unique_ptr<NodeClass>> initialNodeClasses,
+						   std::vector<std::unique_ptr<Node>> initialNodes) {
 	if (!initialized) {
+		nodeClasses = std::move(initialNodeClasses);
 		nodes = std::move(initialNodes);
 		for (const auto& node: nodes) {
 			computeNodes.push_back(node.get());
 		}
 		simgrid::s4u::Engine* engine = simgrid::s4u::Engine::get_instance();
 
-		for (const auto& linkName: Configuration::get("pfs_read_links")) {
+		// generated platforms name their PFS links themselves, platform files have to list them
+		if (!Configuration::exists("platform") &&
+			(!Configuration::exists("pfs_read_links") || !Configuration::exists("pfs_write_links"))) {
+			xbt_die("PFS read and write links have to be specified by pfs_read_links and pfs_write_links");
+		}
+		std::vector<std::string> readLinkNames = PlatformGenerator::getPfsReadLinks();
+		if (Configuration::exists("pfs_read_links")) {
+			readLinkNames = Configuration::get("pfs_read_links").get<std::vector<std::string>>();
+		}
+		std::vector<std::string> writeLinkNames = PlatformGenerator::getPfsWriteLinks();
+		if (Configuration::exists("pfs_write_links")) {
+			writeLinkNames = Configuration::get("pfs_write_links").get<std::vector<std::string>>();
+		}
+
+		for (const auto& linkName: readLinkNames) {
 			s4u_Link* link = engine->link_by_name(linkName);
 			pfsReadBandwidth += engine->link_by_name(linkName)->get_bandwidth();
 			pfsReadLinks.push_back(link);
 		}
 
-		for (const auto& linkName: Configuration::get("pfs_write_links")) {
+		for (const auto& linkName: writeLinkNames) {
 			s4u_Link* link = engine->link_by_name(linkName);
 			pfsWriteBandwidth += engine->link_by_name(linkName)->get_bandwidth();
 			pfsWriteLinks.push_back(link);
@@ -53,6 +78,10 @@ void PlatformManager::init(std::vector<std::unique_ptr<Node>> initialNodes) {
 	}
 }
 
+const std::vector<std::unique_ptr<NodeClass>>& PlatformManager::getNodeClasses() {
+	return nodeClasses;
+}
+
 const std::vector<Node*>& PlatformManager::getComputeNodes() {
 	return computeNodes;
 }
@@ -62,11 +91,15 @@ const std::vector<Node*>& PlatformManager::getModifiedComputeNodes() {
 }
 
 void PlatformManager::addModifiedComputeNode(Node* node) {
-	modifiedComputeNodes.push_back(node);
+	if (modifiedComputeNodesSet.find(node) == modifiedComputeNodesSet.end()) {
+		modifiedComputeNodes.push_back(node);
+		modifiedComputeNodesSet.insert(node);
+	}
 }
 
 void PlatformManager::clearModifiedComputeNodes() {
 	modifiedComputeNodes.clear();
+	modifiedComputeNodesSet.clear();
 }
 
 const std::vector<Job*>& PlatformManager::getModifiedJobs() {
@@ -83,6 +116,16 @@ void PlatformManager::addModifiedJob(Job* job) {
 void PlatformManager::clearModifiedJobs() {
 	modifiedJobs.clear();
 	modifiedJobsSet.clear();
+	releasedJobs.clear();
+}
+
+void PlatformManager::releaseJob(std::unique_ptr<Job> job) {
+	// jobs still pending to be forwarded to the scheduling algorithm are freed after the next invocation
+	if (modifiedJobsSet.find(job.get()) == modifiedJobsSet.end()) {
+		job.reset();
+	} else {
+		releasedJobs.push_back(std::move(job));
+	}
 }
 
 double PlatformManager::getPfsReadUtilization() {
@@ -18,16 +18,21 @@
 
 class Node;
 
+class NodeClass;
+
 class Job;
 
 class PlatformManager {
 
 private:
+	static std::vector<std::unique_ptr<NodeClass>> nodeClasses;
 	static std::vector<std::unique_ptr<Node>> nodes;
 	static std::vector<Node*> computeNodes;
 	static std::vector<Node*> modifiedComputeNodes;
+	static std::unordered_set<Node*> modifiedComputeNodesSet;
 	static std::vector<Job*> modifiedJobs;
 	static std::unordered_set<Job*> modifiedJobsSet;
+	static std::vector<std::unique_ptr<Job>> releasedJobs;
 	static std::vector<s4u_Link*> pfsReadLinks;
 	static std::vector<s4u_Link*> pfsWriteLinks;
 	static double pfsReadBandwidth;
@@ -35,7 +40,10 @@ private:
 	static bool initialized;
 
 public:
-	static void init(std::vector<std::unique_ptr<Node>> initialNodes);
+	static void init(std::vector<std::unique_ptr<NodeClass>> initialNodeClasses,
+					 std::vector<std::unique_ptr<Node>> initialNodes);
+
+	[[nodiscard]] static const std::vector<std::unique_ptr<NodeClass>>& getNodeClasses();
 
 	[[nodiscard]] static const std::vector<Node*>& getComputeNodes();
 
@@ -51,6 +59,8 @@ public:
 
 	static void clearModifiedJobs();
 
+	static void releaseJob(std::unique_ptr<Job> job);
+
 	[[nodiscard]] static double getPfsReadUtilization();
 
 	[[nodiscard]] static double getPfsWriteUtilization();
@@ -20,6 +20,7 @@
 #include "Configuration.h"
 #include "SchedulingInterface.h"
 #include "PlatformManager.h"
+#include "Profiler.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(Scheduler, "Messages within the Scheduler actor");
 
@@ -47,6 +48,8 @@ void Scheduler::schedule(InvocationType invocationType, Job* requestingJob, int
 		if (invocationType == INVOKE_SCHEDULING_POINT || invocationType == INVOKE_EVOLVING_REQUEST) {
 			if (requestingJob->getState() == PENDING_KILL) {
 				forwardJobKill(requestingJob, false);
+			} else if (requestingJob->getState() == PENDING_SUSPENSION) {
+				forwardJobSuspension(requestingJob, false);
 			} else if (requestingJob->getState() == PENDING_RECONFIGURATION) {
 				handleReconfiguration(requestingJob);
 			} else {
@@ -62,6 +65,10 @@ void Scheduler::schedule(InvocationType invocationType, Job* requestingJob, int
 				forwardJobAllocation(job);
 			} else if (job->getState() == PENDING_KILL) {
 				forwardJobKill(job, false);
+			} else if (job->getState() == PENDING_SUSPENSION) {
+				forwardJobSuspension(job, true);
+			} else if (job->getState() == PENDING_RESUMPTION) {
+				forwardJobResumption(job);
 			}
 		}
 		lastInvocation = clock;
@@ -77,6 +84,16 @@ void Scheduler::handleJobSubmit(Job* job) {
 	}
 }
 
+void Scheduler::releaseJob(Job* job) {
+	auto walltimeMonitor = walltimeMonitors.find(job);
+	if (walltimeMonitor != walltimeMonitors.end()) {
+		walltimeMonitors.erase(walltimeMonitor);
+	}
+	assignedNodes.erase(job);
+	jobQueue[job->getId()] = nullptr;
+	job->releaseWorkload();
+}
+
 void Scheduler::handleProcessedWorkload(Job* job) {
 	for (const auto& node: job->getExecutingNodes()) {
 		node->completeJob(job);
@@ -86,23 +103,26 @@ void Scheduler::handleProcessedWorkload(Job* job) {
 	if (job->getWalltime() > 0) {
 		walltimeMonitors[job]->kill();
 	}
+	releaseJob(job);
 	s4u_Mailbox* mailboxSimulator = s4u_Mailbox::by_name("SimulationEngine");
-	mailboxSimulator->put_init(new SimMsg(JOB_COMPLETED, job->getId()), 0)->detach();
+	mailboxSimulator->put_init(new SimMsg(JOB_COMPLETED, job), 0)->detach();
 	if (scheduleOnJobFinalize) {
 		schedule(INVOKE_JOB_COMPLETED, job);
 	}
 }
 
 void Scheduler::forwardJobKill(Job* job, bool exceededWalltime) {
-	if (job->getWalltime() > 0 && !exceededWalltime) {
-		walltimeMonitors[job]->kill();
+	auto walltimeMonitor = walltimeMonitors.find(job);
+	if (walltimeMonitor != walltimeMonitors.end() && !exceededWalltime) {
+		walltimeMonitor->second->kill();
 	}
 	for (const auto& node: job->getExecutingNodes()) {
 		node->killJob(job);
 	}
 	job->setState(KILLED);
+	releaseJob(job);
 	s4u_Mailbox* mailboxSimulator = s4u_Mailbox::by_name("SimulationEngine");
-	mailboxSimulator->put_init(new SimMsg(JOB_KILLED, job->getId()), 0)->detach();
+	mailboxSimulator->put_init(new SimMsg(JOB_KILLED, job), 0)->detach();
 	if (exceededWalltime && scheduleOnJobFinalize) {
 		schedule(INVOKE_JOB_KILLED, job);
 	}
@@ -117,55 +137,116 @@ void Scheduler::forwardJobAllocation(Job* job) {
 		node->allocateJob(job, rank++, barrier);
 	}
 	if (job->getWalltime() > 0) {
+		Profiler::count(COUNT_WALLTIME_MONITOR_ACTORS);
 		walltimeMonitors[job] = s4u_Actor::create("WalltimeMonitor@Job" + std::to_string(job->getId()),
 												  masterHost, WalltimeMonitor(job, gracePeriod));
 	}
 }
 
+void Scheduler::forwardJobSuspension(Job* job, bool running) {
+	// the walltime only elapses while the job executes
+	auto walltimeMonitor = walltimeMonitors.find(job);
+	if (walltimeMonitor != walltimeMonitors.end()) {
+		walltimeMonitor->second->suspend();
+	}
+	if (job->isRetainingNodes()) {
+		if (running) {
+			for (const auto& node: job->getExecutingNodes()) {
+				node->suspendJob(job);
+			}
+		}
+	} else {
+		if (running) {
+			// restart from the last phase iteration completed by all ranks, later progress is lost
+			std::pair<int, int> checkpoint = job->getCheckpoint();
+			for (const auto& node: job->getExecutingNodes()) {
+				node->killJob(job);
+			}
+			if (checkpoint.first >= 0) {
+				job->advanceWorkload(checkpoint.first, checkpoint.second);
+			}
+		} else {
+			for (const auto& node: job->getExecutingNodes()) {
+				node->completeJob(job);
+			}
+		}
+		assignedNodes.erase(job);
+	}
+	job->setState(SUSPENDED);
+}
+
+void Scheduler::forwardJobResumption(Job* job) {
+	job->setState(RUNNING);
+	if (job->isRetainingNodes()) {
+		for (const auto& node: job->getExecutingNodes()) {
+			node->resumeJob(job);
+		}
+	} else {
+		int rank = 0;
+		simgrid::s4u::BarrierPtr barrier = s4u_Barrier::create(job->getNumberOfExecutingNodes());
+		for (const auto& node: job->getExecutingNodes()) {
+			assignedNodes[job].insert(node);
+			node->allocateJob(job, rank++, barrier, true);
+		}
+	}
+	auto walltimeMonitor = walltimeMonitors.find(job);
+	if (walltimeMonitor != walltimeMonitors.end()) {
+		walltimeMonitor->second->resume();
+	}
+}
+
+bool Scheduler::isAwaitingContinuation(Job* job) {
+	// a job suspended while its scheduling point was queued is continued by its resumption instead
+	if (job->getState() == SUSPENDED || job->getState() == PENDING_SUSPENSION) {
+		return false;
+	}
+	return job->getExecutingNodes().front()->hasExited(job);
+}
+
 void Scheduler::handleReconfiguration(Job* job) {
 
 	// continue with reconfiguration
-	std::set<Node*> previousNodes(std::begin(job->getExecutingNodes()),
-								  std::end(job->getExecutingNodes()));
+	NodeSet previousNodes = job->getExecutingNodeSet();
 
 	// setting the state implies taking over new nodes
 	job->setState(IN_RECONFIGURATION);
-	std::set<Node*> newNodes(std::begin(job->getExecutingNodes()),
-							 std::end(job->getExecutingNodes()));
+	const NodeSet& newNodes = job->getExecutingNodeSet();
+	NodeSet retainedNodes = previousNodes & newNodes;
 
 	int rank = 0;
-	std::map<Node*, int> ranks;
+	std::vector<int> ranks;
 	std::vector<Node*> expandNodes;
 	simgrid::s4u::BarrierPtr barrier = s4u_Barrier::create(job->getExecutingNodes().size());
 
 	// reconfigure retained nodes or accumulate new nodes to expand
 	for (const auto& node: job->getExecutingNodes()) {
 		assignedNodes[job].insert(node);
-		if (previousNodes.find(node) != previousNodes.end()) {
+		if (retainedNodes.contains(node)) {
 			node->reconfigureJob(job, rank++, barrier);
 		} else {
 			expandNodes.push_back(node);
-			ranks[node] = rank++;
+			ranks.push_back(rank++);
 		}
 	}
 
 	// set and inform expanding nodes for eventual initialization tasks
-	int expandRank = 0;
 	job->setExpandNodes(expandNodes);
 	simgrid::s4u::BarrierPtr expandBarrier = s4u_Barrier::create(expandNodes.size());
-	for (const auto& node: expandNodes) {
-		node->expandJob(job, ranks[node], expandRank++, barrier, expandBarrier);
+	for (size_t expandRank = 0; expandRank < expandNodes.size(); ++expandRank) {
+		expandNodes[expandRank]->expandJob(job, ranks[expandRank], expandRank, barrier, expandBarrier);
 	}
 
 	// deallocate nodes which are no longer assigned in this configuration
-	for (const auto& node: previousNodes) {
-		if (newNodes.find(node) == newNodes.end()) {
-			node->completeJob(job);
-		}
+	for (const auto& node: (previousNodes - newNodes).resolve(PlatformManager::getComputeNodes())) {
+		node->completeJob(job);
 	}
 }
 
 void Scheduler::handleSchedulingPoint(Job* job) {
+	if (!isAwaitingContinuation(job)) {
+		XBT_INFO("Job %d has been suspended since its scheduling point", job->getId());
+		return;
+	}
 	if (scheduleOnSchedulingPoint) {
 		schedule(INVOKE_SCHEDULING_POINT, job);
 	} else {
@@ -185,6 +266,10 @@ void Scheduler::handleSchedulingPoint(Job* job) {
 }
 
 void Scheduler::handleEvolvingRequest(Job* job, int numberOfnodes) {
+	if (!isAwaitingContinuation(job)) {
+		XBT_INFO("Job %d has been suspended since its evolving request", job->getId());
+		return;
+	}
 	schedule(INVOKE_EVOLVING_REQUEST, job, numberOfnodes);
 }
 
@@ -215,6 +300,7 @@ void Scheduler::operator()() {
 	// main loop
 	while (true) {
 		const auto& payload = mailboxScheduler->get_unique<SchedMsg>();
+		Profiler::count(COUNT_EVENTS);
 		if (payload->getType() == INVOKE_SCHEDULING) {
 			schedule(INVOKE_PERIODIC);
 		} else if (payload->getType() == JOB_SUBMIT) {
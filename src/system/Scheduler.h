@@ -14,6 +14,7 @@
 #define EPSILON 0.001
 
 #include "Job.h"
+#include "NodeSet.h"
 #include <memory>
 
 class Node;
@@ -45,19 +46,27 @@ private:
 	std::vector<Job*> jobQueue;
 	std::vector<Job*> modifiedJobs;
 	std::map<Job*, simgrid::s4u::ActorPtr> walltimeMonitors;
-	std::map<Job*, std::set<Node*>> assignedNodes;
+	std::map<Job*, NodeSet> assignedNodes;
 	int currentJobId;
 
 	void schedule(InvocationType invocationType, Job* requestingJob = nullptr, int numberOfNodes = -1);
 
 	void handleJobSubmit(Job* job);
 
+	void releaseJob(Job* job);
+
 	void handleProcessedWorkload(Job* job);
 
 	void forwardJobKill(Job* job, bool exceededWalltime);
 
 	void forwardJobAllocation(Job* job);
 
+	void forwardJobSuspension(Job* job, bool running);
+
+	void forwardJobResumption(Job* job);
+
+	[[nodiscard]] static bool isAwaitingContinuation(Job* job);
+
 	void handleReconfiguration(Job* job);
 
 	void handleSchedulingPoint(Job* job);
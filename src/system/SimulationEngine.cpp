@@ -24,11 +24,50 @@
 #include "SimMsg.h"
 #include "SchedMsg.h"
 #include "Configuration.h"
+#include "Profiler.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(SimulationEngine, "Messages within the SimulationEngine actor");
 
 SimulationEngine::SimulationEngine() = default;
 
+void SimulationEngine::writeStatistics(std::ofstream& jobStatistics, const Job* job) {
+	jobStatistics << job->getId() << ",";
+	switch (job->getType()) {
+		case RIGID:
+			jobStatistics << "rigid" << ",";
+			break;
+		case MOLDABLE:
+			jobStatistics << "moldable" << ",";
+			break;
+		case MALLEABLE:
+			jobStatistics << "malleable" << ",";
+			break;
+		case EVOLVING:
+			jobStatistics << "evolving" << ",";
+			break;
+		case ADAPTIVE:
+			jobStatistics << "adaptive" << ",";
+			break;
+	}
+	jobStatistics << job->getSubmitTime() << ",";
+	jobStatistics << job->getStartTime() << ",";
+	jobStatistics << job->getEndTime() << ",";
+	jobStatistics << job->getWaitTime() << ",";
+	jobStatistics << job->getMakespan() << ",";
+	jobStatistics << job->getTurnaroundTime() << ",";
+	if (job->getState() == COMPLETED) {
+		jobStatistics << "completed" << ",";
+	} else if (job->getState() == KILLED) {
+		jobStatistics << "killed" << ",";
+	} else {
+		xbt_die("Invalid final job status");
+	}
+	jobStatistics << job->getNumReconfigurations() << ",";
+	jobStatistics << job->getTotalReconfigurationOverhead() << ",";
+	jobStatistics << job->getNumSuspensions() << ",";
+	jobStatistics << job->getSuspendedTime() << std::endl;
+}
+
 void SimulationEngine::operator()() {
 
 	// initialization
@@ -36,11 +75,12 @@ void SimulationEngine::operator()() {
 	s4u_Mailbox* mailboxScheduler = s4u_Mailbox::by_name("Scheduler");
 
 	std::ofstream jobStatistics(Configuration::get("job_statistics"));
+	jobStatistics << "ID,Type,Submit Time,Start Time,End Time,Wait Time,Makespan,Turnaround Time,Status,"
+					 "Reconfigurations,Reconfiguration Overhead,Suspensions,Suspended Time" << std::endl;
 
 	const auto& numJobsMsg = mailboxSimulator->get_unique<SimMsg>();
 	size_t expectedJobs = numJobsMsg->getNumberOfJobs();
-	std::vector<std::unique_ptr<Job>> jobs;
-	jobs.reserve(expectedJobs);
+	std::unordered_map<const Job*, std::unique_ptr<Job>> jobs;
 
 	indicators::BlockProgressBar progressBar{
 			indicators::option::BarWidth{80},
@@ -65,24 +105,32 @@ void SimulationEngine::operator()() {
 	size_t numberOfJobs = expectedJobs;
 	while (expectedJobs > 0) {
 		const auto& payload = mailboxSimulator->get_unique<SimMsg>();
+		Profiler::count(COUNT_EVENTS);
 		if (payload->getType() == SUBMIT_JOB) {
 			XBT_INFO("Registered job submission");
-			jobs.push_back(payload->getJob());
-			mailboxScheduler->put(new SchedMsg(JOB_SUBMIT, jobs.back().get()), 0);
-		} else if (payload->getType() == JOB_COMPLETED) {
-			XBT_INFO("Registered job completion");
-			expectedJobs--;
-			if (showProgressBar) {
-				progressBar.set_option(indicators::option::PostfixText{
-						std::to_string(++processedJobs) + "/" + std::to_string(numberOfJobs) + " jobs processed"});
-				progressBar.tick();
+			std::unique_ptr<Job> job = payload->getJob();
+			Job* submittedJob = job.get();
+			jobs[submittedJob] = std::move(job);
+			mailboxScheduler->put(new SchedMsg(JOB_SUBMIT, submittedJob), 0);
+		} else if (payload->getType() == JOB_COMPLETED || payload->getType() == JOB_KILLED) {
+			if (payload->getType() == JOB_COMPLETED) {
+				XBT_INFO("Registered job completion");
+			} else {
+				XBT_INFO("Registered job kill");
 			}
-		} else if (payload->getType() == JOB_KILLED) {
-			XBT_INFO("Registered job kill");
+			// write statistics right away and free the job once the scheduling algorithm has been informed
+			auto job = jobs.find(payload->getFinishedJob());
+			writeStatistics(jobStatistics, job->second.get());
+			PlatformManager::releaseJob(std::move(job->second));
+			jobs.erase(job);
 			expectedJobs--;
 			if (showProgressBar) {
-				progressBar.set_option(indicators::option::PostfixText{
-						std::to_string(++processedJobs) + "/" + std::to_string(numberOfJobs) + " jobs processed"});
+				std::string postfix = std::to_string(++processedJobs) + "/" + std::to_string(numberOfJobs) +
+									  " jobs processed";
+				if (!Profiler::getThroughput().empty()) {
+					postfix += " (" + Profiler::getThroughput() + ")";
+				}
+				progressBar.set_option(indicators::option::PostfixText{postfix});
 				progressBar.tick();
 			}
 		}
@@ -97,39 +145,4 @@ void SimulationEngine::operator()() {
 	XBT_INFO("Send finalization");
 	mailboxScheduler->put(new SchedMsg(SCHEDULER_FINALIZE), 0);
 
-	jobStatistics << "ID,Type,Submit Time,Start Time,End Time,Wait Time,Makespan,Turnaround Time,Status" << std::endl;
-	for (const auto& job: jobs) {
-		jobStatistics << job->getId() << ",";
-		switch (job->getType()) {
-			case RIGID:
-				jobStatistics << "rigid" << ",";
-				break;
-			case MOLDABLE:
-				jobStatistics << "moldable" << ",";
-				break;
-			case MALLEABLE:
-				jobStatistics << "malleable" << ",";
-				break;
-			case EVOLVING:
-				jobStatistics << "evolving" << ",";
-				break;
-			case ADAPTIVE:
-				jobStatistics << "adaptive" << ",";
-				break;
-		}
-		jobStatistics << job->getSubmitTime() << ",";
-		jobStatistics << job->getStartTime() << ",";
-		jobStatistics << job->getEndTime() << ",";
-		jobStatistics << job->getWaitTime() << ",";
-		jobStatistics << job->getMakespan() << ",";
-		jobStatistics << job->getTurnaroundTime() << ",";
-		if (job->getState() == COMPLETED) {
-			jobStatistics << "completed" << std::endl;
-		} else if (job->getState() == KILLED) {
-			jobStatistics << "killed" << std::endl;
-		} else {
-			xbt_die("Invalid final job status");
-		}
-	}
-
 }
@@ -11,10 +11,15 @@
 #ifndef ELASTISIM_SIMULATIONENGINE_H
 #define ELASTISIM_SIMULATIONENGINE_H
 
+#include <fstream>
+
 class Job;
 
 class SimulationEngine {
 
+private:
+	static void writeStatistics(std::ofstream& jobStatistics, const Job* job);
+
 public:
 	SimulationEngine();
 
@@ -14,9 +14,13 @@
 #include "Phase.h"
 #include "Task.h"
 
-SimMsg::SimMsg(SimEventType type, size_t numberOfJobs) : type(type), numberOfJobs(numberOfJobs) {}
+SimMsg::SimMsg(SimEventType type, size_t numberOfJobs) :
+		type(type), numberOfJobs(numberOfJobs), finishedJob(nullptr) {}
 
-SimMsg::SimMsg(SimEventType type, std::unique_ptr<Job> job) : type(type), numberOfJobs(-1), job(std::move(job)) {}
+SimMsg::SimMsg(SimEventType type, std::unique_ptr<Job> job) :
+		type(type), numberOfJobs(-1), job(std::move(job)), finishedJob(nullptr) {}
+
+SimMsg::SimMsg(SimEventType type, Job* finishedJob) : type(type), numberOfJobs(-1), finishedJob(finishedJob) {}
 
 SimEventType SimMsg::getType() const {
 	return type;
@@ -29,3 +33,7 @@ size_t SimMsg::getNumberOfJobs() const {
 std::unique_ptr<Job> SimMsg::getJob() {
 	return std::move(job);
 }
+
+Job* SimMsg::getFinishedJob() const {
+	return finishedJob;
+}
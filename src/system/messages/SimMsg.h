@@ -28,18 +28,23 @@ private:
 	const SimEventType type;
 	const size_t numberOfJobs;
 	std::unique_ptr<Job> job;
+	Job* finishedJob;
 
 public:
 	SimMsg(SimEventType type, size_t numberOfJobs);
 
 	SimMsg(SimEventType type, std::unique_ptr<Job> job);
 
+	SimMsg(SimEventType type, Job* finishedJob);
+
 	[[nodiscard]] SimEventType getType() const;
 
 	[[nodiscard]] size_t getNumberOfJobs() const;
 
 	[[nodiscard]] std::unique_ptr<Job> getJob();
 
+	[[nodiscard]] Job* getFinishedJob() const;
+
 };
 
 
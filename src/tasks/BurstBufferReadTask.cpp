@@ -11,6 +11,8 @@
 #include "BurstBufferReadTask.h"
 #include "Node.h"
 #include "Job.h"
+#include "Profiler.h"
+#include "Communication.h"
 
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(BurstBufferReadTask,
@@ -33,29 +35,45 @@ std::vector<simgrid::s4u::ActivityPtr>
 BurstBufferReadTask::executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const {
 	if (node->getType() == COMPUTE_NODE_WITH_BB) {
 		XBT_INFO("Reading %f bytes from burst buffer", ioSizes[rank]);
-		return {node->getNodeLocalBurstBuffer()->read_async(ioSizes[rank])};
+		Profiler::countActivities(ACTIVITY_IO, job->getType());
+		return node->trackActivities(job, {node->getNodeLocalBurstBuffer()->read_async(ioSizes[rank])});
 	} else if (node->getType() == COMPUTE_NODE_WITH_WIDE_STRIPED_BB) {
 		XBT_INFO("Reading %f bytes from wide-striped burst buffers", ioSizes[rank]);
-		std::vector<simgrid::s4u::ActivityPtr> activities;
+		// every stripe travels from its source to this node on its own, sparing the dense matrix over
+		// all assigned nodes of which only this rank's column was ever filled
 		int numNodes = nodes.size();
 		double sizePerHost = ioSizes[rank] / numNodes;
-		std::vector<simgrid::s4u::Host*> hosts;
-		std::vector<double> flops;
-		std::vector<double> payloads(numNodes * numNodes);
-		int nodeRank = 0;
+		const std::vector<double> payloads = {0, sizePerHost, 0, 0};
+		std::vector<simgrid::s4u::ActivityPtr> activities;
+		activities.reserve(2 * numNodes);
 		for (const auto& assignedNode: nodes) {
-			hosts.emplace_back(assignedNode->getHost());
-			flops.emplace_back(assignedNode->getFlopsPerByte() * sizePerHost);
 			activities.emplace_back(assignedNode->getNodeLocalBurstBuffer()->read_async(sizePerHost));
-			int index = nodeRank++ * numNodes + rank;
-			if (assignedNode == node) continue;
-			payloads[index] = sizePerHost;
+			double flops = assignedNode->getFlopsPerByte() * sizePerHost;
+			if (assignedNode != node && !Communication::usesFlows()) {
+				std::vector<simgrid::s4u::Host*> hosts = {assignedNode->getHost(), node->getHost()};
+				Profiler::countActivities(ACTIVITY_PTASK, job->getType());
+				simgrid::s4u::ActivityPtr stripe = simgrid::s4u::this_actor::exec_init(hosts, {flops, 0}, payloads);
+				stripe->start();
+				activities.emplace_back(stripe);
+				continue;
+			}
+			if (assignedNode != node) {
+				activities.emplace_back(
+						Communication::send(assignedNode->getHost(), node->getHost(), sizePerHost, job));
+			}
+			if (flops > 0) {
+				Profiler::countActivities(ACTIVITY_EXEC, job->getType());
+				activities.emplace_back(assignedNode->getHost()->exec_async(flops));
+			}
 		}
-		simgrid::s4u::ActivityPtr parallelActivity = simgrid::s4u::this_actor::exec_init(hosts, flops, payloads);
-		parallelActivity->start();
-		activities.emplace_back(parallelActivity);
-		return activities;
+		Profiler::countActivities(ACTIVITY_IO, job->getType(), numNodes);
+		return node->trackActivities(job, std::move(activities));
 	} else {
 		xbt_die("No burst buffer available on node %s", node->getHostName().c_str());
 	}
 }
+
+double BurstBufferReadTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+											  const std::map<std::string, std::string>& runtimeArguments) const {
+	return estimateBurstBuffer(nodes, getIoSizes((int) nodes.size(), numGpusPerNode, runtimeArguments), true);
+}
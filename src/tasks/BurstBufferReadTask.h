@@ -17,6 +17,11 @@
 
 class BurstBufferReadTask : public IoTask {
 
+protected:
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
+
 public:
 	BurstBufferReadTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 						const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
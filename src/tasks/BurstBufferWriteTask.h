@@ -18,6 +18,11 @@
 
 class BurstBufferWriteTask : public IoTask {
 
+protected:
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
+
 public:
 	BurstBufferWriteTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 						 const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
@@ -12,6 +12,7 @@
 
 #include <simgrid/s4u.hpp>
 #include "Node.h"
+#include "Profiler.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(BusyWaitTask, "Messages within the busy wait task");
 
@@ -23,5 +24,6 @@ BusyWaitTask::BusyWaitTask(const std::string& name, const std::string& iteration
 void BusyWaitTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 						   simgrid::s4u::BarrierPtr barrier) const {
 	XBT_INFO("Waiting %f seconds", delays[rank]);
+	Profiler::countActivities(ACTIVITY_EXEC, job->getType());
 	node->getHost()->execute(delays[rank] * node->getHost()->get_speed());
 }
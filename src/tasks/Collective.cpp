@@ -0,0 +1,268 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "Collective.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Node.h"
+#include "Profiler.h"
+#include "Communication.h"
+
+Collective::Collective(CollectiveOperation operation, CollectiveAlgorithm algorithm, bool analytic, double bytes,
+					   CollectiveAlgorithm intraNodeAlgorithm) :
+		operation(operation), algorithm(algorithm), intraNodeAlgorithm(intraNodeAlgorithm), analytic(analytic),
+		bytes(bytes) {}
+
+bool Collective::isAvailable(CollectiveOperation operation, CollectiveAlgorithm algorithm) {
+	switch (operation) {
+		case COLLECTIVE_ALLREDUCE:
+			return true;
+		case COLLECTIVE_BCAST:
+		case COLLECTIVE_ALLGATHER:
+			return algorithm != ALGORITHM_RABENSEIFNER;
+		case COLLECTIVE_REDUCE_SCATTER:
+			return algorithm != ALGORITHM_BINOMIAL_TREE;
+		case COLLECTIVE_ALLTOALL:
+			return algorithm == ALGORITHM_RING || algorithm == ALGORITHM_RECURSIVE_DOUBLING;
+	}
+	return false;
+}
+
+int Collective::getPowerOfTwo(int numRanks) {
+	int powerOfTwo = 1;
+	while (powerOfTwo * 2 <= numRanks) {
+		powerOfTwo *= 2;
+	}
+	return powerOfTwo;
+}
+
+const std::vector<Collective::Step>& Collective::getSteps(int numRanks) const {
+	auto it = steps.find(numRanks);
+	if (it != std::end(steps)) {
+		return it->second;
+	}
+	std::vector<Step>& numRanksSteps = steps[numRanks];
+	if (numRanks < 2) {
+		return numRanksSteps;
+	}
+	int powerOfTwo = getPowerOfTwo(numRanks);
+	bool folded = powerOfTwo < numRanks;
+	// shares are fractions of the buffer size sent by every active rank in a step
+	const auto& add = [&numRanksSteps](StepType type, int distance, double share) {
+		numRanksSteps.push_back({type, distance, share});
+	};
+	const auto& foldIn = [&](double share) { if (folded) add(STEP_FOLD_IN, 0, share); };
+	const auto& foldOut = [&](double share) { if (folded) add(STEP_FOLD_OUT, 0, share); };
+	const auto& halve = [&]() {
+		for (int mask = powerOfTwo / 2; mask >= 1; mask /= 2) {
+			add(STEP_EXCHANGE, mask, (double) mask / powerOfTwo);
+		}
+	};
+	const auto& doubleUp = [&]() {
+		for (int mask = 1; mask < powerOfTwo; mask *= 2) {
+			add(STEP_EXCHANGE, mask, (double) mask / powerOfTwo);
+		}
+	};
+	const auto& broadcast = [&]() {
+		for (int distance = 1; distance < numRanks; distance *= 2) {
+			add(STEP_TREE_DOWN, distance, 1);
+		}
+	};
+
+	switch (operation) {
+		case COLLECTIVE_ALLREDUCE:
+			if (algorithm == ALGORITHM_RING) {
+				// reduce-scatter followed by allgather around the ring
+				for (int i = 0; i < 2 * (numRanks - 1); ++i) {
+					add(STEP_SHIFT, 1, 1.0 / numRanks);
+				}
+			} else if (algorithm == ALGORITHM_RECURSIVE_DOUBLING) {
+				foldIn(1);
+				for (int mask = 1; mask < powerOfTwo; mask *= 2) {
+					add(STEP_EXCHANGE, mask, 1);
+				}
+				foldOut(1);
+			} else if (algorithm == ALGORITHM_BINOMIAL_TREE) {
+				for (int distance = 1; distance < numRanks; distance *= 2) {
+					add(STEP_TREE_UP, distance, 1);
+				}
+				broadcast();
+			} else {
+				// recursive halving reduce-scatter followed by recursive doubling allgather
+				foldIn(1);
+				halve();
+				doubleUp();
+				foldOut(1);
+			}
+			break;
+		case COLLECTIVE_BCAST:
+			if (algorithm == ALGORITHM_RING) {
+				for (int i = 0; i < numRanks - 1; ++i) {
+					add(STEP_CHAIN, i, 1);
+				}
+			} else {
+				broadcast();
+			}
+			break;
+		case COLLECTIVE_ALLGATHER:
+			if (algorithm == ALGORITHM_RING) {
+				for (int i = 0; i < numRanks - 1; ++i) {
+					add(STEP_SHIFT, 1, 1.0 / numRanks);
+				}
+			} else if (algorithm == ALGORITHM_RECURSIVE_DOUBLING) {
+				foldIn(1.0 / numRanks);
+				doubleUp();
+				foldOut(1);
+			} else {
+				for (int distance = 1; distance < numRanks; distance *= 2) {
+					add(STEP_TREE_UP, distance, std::min(1.0, (double) distance / numRanks));
+				}
+				broadcast();
+			}
+			break;
+		case COLLECTIVE_REDUCE_SCATTER:
+			if (algorithm == ALGORITHM_RING) {
+				for (int i = 0; i < numRanks - 1; ++i) {
+					add(STEP_SHIFT, 1, 1.0 / numRanks);
+				}
+			} else {
+				foldIn(1);
+				halve();
+				foldOut(1.0 / numRanks);
+			}
+			break;
+		case COLLECTIVE_ALLTOALL:
+			if (algorithm == ALGORITHM_RING) {
+				// pairwise exchange, every rank sends one block per step
+				for (int distance = 1; distance < numRanks; ++distance) {
+					add(STEP_SHIFT, distance, 1.0 / numRanks);
+				}
+			} else {
+				// Bruck's algorithm, every rank forwards the blocks whose index has the bit of the distance set
+				for (int distance = 1; distance < numRanks; distance *= 2) {
+					int blocks = 0;
+					for (int block = 0; block < numRanks; ++block) {
+						blocks += (block & distance) != 0;
+					}
+					add(STEP_SHIFT, distance, (double) blocks / numRanks);
+				}
+			}
+			break;
+	}
+	return numRanksSteps;
+}
+
+int Collective::getDestination(const Step& step, int rank, int numRanks, int powerOfTwo) {
+	switch (step.type) {
+		case STEP_SHIFT:
+			return (rank + step.distance) % numRanks;
+		case STEP_EXCHANGE:
+			return rank < powerOfTwo ? rank ^ step.distance : -1;
+		case STEP_TREE_DOWN:
+			return rank < step.distance && rank + step.distance < numRanks ? rank + step.distance : -1;
+		case STEP_TREE_UP:
+			return rank % (2 * step.distance) == step.distance ? rank - step.distance : -1;
+		case STEP_FOLD_IN:
+			return rank >= powerOfTwo ? rank - powerOfTwo : -1;
+		case STEP_FOLD_OUT:
+			return rank < numRanks - powerOfTwo ? rank + powerOfTwo : -1;
+		case STEP_CHAIN:
+			return rank == step.distance ? rank + 1 : -1;
+	}
+	return -1;
+}
+
+double Collective::estimate(const std::vector<Node*>& nodes) const {
+	int numRanks = (int) nodes.size();
+	if (numRanks < 2) {
+		return 0;
+	}
+	std::vector<simgrid::s4u::Link*> links;
+	double latency = 0;
+	nodes[0]->getHost()->route_to(nodes[1]->getHost(), links, &latency);
+	double bandwidth = std::numeric_limits<double>::infinity();
+	for (const auto& link: links) {
+		bandwidth = std::min(bandwidth, link->get_bandwidth());
+	}
+	double time = 0;
+	for (const Step& step: getSteps(numRanks)) {
+		time += latency + step.share * bytes / bandwidth;
+	}
+	return time;
+}
+
+std::vector<double> Collective::getBytesPerRank(int numRanks) const {
+	// the bytes every rank sends to other ranks when executing the operation
+	std::vector<double> bytesPerRank(numRanks, 0);
+	int powerOfTwo = getPowerOfTwo(numRanks);
+	for (const Step& step: getSteps(numRanks)) {
+		for (int rank = 0; rank < numRanks; ++rank) {
+			int destination = getDestination(step, rank, numRanks, powerOfTwo);
+			if (destination >= 0 && destination != rank) {
+				bytesPerRank[rank] += step.share * bytes;
+			}
+		}
+	}
+	return bytesPerRank;
+}
+
+void Collective::setBytes(double bytes) {
+	this->bytes = bytes;
+}
+
+std::pair<double, double> Collective::getIntraNodeBytes(int numNodes, int numGpusPerNode) const {
+	if (numGpusPerNode < 2) {
+		return {0, 0};
+	}
+	// bytes each GPU moves over the link: reduce-scatter, allgather, gather and scatter move all but the own share,
+	// rooted operations move the whole buffer once along the ring or once per tree level
+	double distributed = bytes * (numGpusPerNode - 1) / numGpusPerNode;
+	double rooted = bytes;
+	if (intraNodeAlgorithm == ALGORITHM_BINOMIAL_TREE) {
+		rooted *= std::ceil(std::log2(numGpusPerNode));
+	}
+	bool ring = intraNodeAlgorithm == ALGORITHM_RING;
+	switch (operation) {
+		case COLLECTIVE_ALLREDUCE:
+			return ring ? std::make_pair(distributed, distributed) : std::make_pair(rooted, rooted);
+		case COLLECTIVE_BCAST:
+			return {0, rooted};
+		case COLLECTIVE_ALLGATHER:
+			return {distributed / numNodes, rooted};
+		case COLLECTIVE_REDUCE_SCATTER:
+			return {ring ? distributed : rooted, distributed / numNodes};
+		case COLLECTIVE_ALLTOALL:
+			return {distributed, 0};
+	}
+	return {0, 0};
+}
+
+void Collective::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
+						 const simgrid::s4u::BarrierPtr& barrier) const {
+	Profiler::count(COUNT_BARRIER_WAITS);
+	barrier->wait();
+	if (analytic) {
+		simgrid::s4u::this_actor::sleep_for(estimate(nodes));
+		return;
+	}
+	int numRanks = (int) nodes.size();
+	int powerOfTwo = getPowerOfTwo(numRanks);
+	for (const Step& step: getSteps(numRanks)) {
+		int destination = getDestination(step, rank, numRanks, powerOfTwo);
+		double stepBytes = step.share * bytes;
+		if (destination >= 0 && destination != rank && stepBytes > 0) {
+			Communication::send(node->getHost(), nodes[destination]->getHost(), stepBytes, job)->wait();
+		}
+		Profiler::count(COUNT_BARRIER_WAITS);
+		barrier->wait();
+	}
+}
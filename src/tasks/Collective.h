@@ -0,0 +1,99 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_COLLECTIVE_H
+#define ELASTISIM_COLLECTIVE_H
+
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <simgrid/s4u.hpp>
+
+class Node;
+
+class Job;
+
+enum CollectiveOperation {
+	COLLECTIVE_ALLREDUCE,
+	COLLECTIVE_BCAST,
+	COLLECTIVE_ALLGATHER,
+	COLLECTIVE_REDUCE_SCATTER,
+	COLLECTIVE_ALLTOALL
+};
+
+enum CollectiveAlgorithm {
+	ALGORITHM_RING,
+	ALGORITHM_RECURSIVE_DOUBLING,
+	ALGORITHM_BINOMIAL_TREE,
+	ALGORITHM_RABENSEIFNER
+};
+
+// Collective operation on a buffer of the given size (the full vector for reductions and broadcasts, the gathered
+// result for allgather, the send buffer for alltoall). The algorithm is expanded into steps in which every rank sends
+// to at most one peer, so each step is a set of sparse point-to-point transfers. Non-power-of-two rank counts are
+// folded onto the largest power of two for the recursive algorithms. Alternatively, the steps are only summed up as
+// latency plus size over bandwidth of the route between the first two nodes (LogGP without overheads).
+// GPU collectives are hierarchical: the node's GPUs combine their buffers over the GPU link (ring or binomial tree)
+// before the node leaders run the inter-node algorithm, and distribute the result over the GPU link afterwards.
+class Collective {
+
+private:
+	enum StepType {
+		STEP_SHIFT,
+		STEP_EXCHANGE,
+		STEP_TREE_DOWN,
+		STEP_TREE_UP,
+		STEP_FOLD_IN,
+		STEP_FOLD_OUT,
+		STEP_CHAIN
+	};
+
+	struct Step {
+		StepType type;
+		int distance;
+		double share;
+	};
+
+	const CollectiveOperation operation;
+	const CollectiveAlgorithm algorithm;
+	const CollectiveAlgorithm intraNodeAlgorithm;
+	const bool analytic;
+	double bytes;
+	// steps by number of ranks, entries are never invalidated since executing ranks iterate them across barriers
+	mutable std::unordered_map<int, std::vector<Step>> steps;
+
+	[[nodiscard]] static int getPowerOfTwo(int numRanks);
+
+	const std::vector<Step>& getSteps(int numRanks) const;
+
+	[[nodiscard]] static int getDestination(const Step& step, int rank, int numRanks, int powerOfTwo);
+
+public:
+	Collective(CollectiveOperation operation, CollectiveAlgorithm algorithm, bool analytic, double bytes,
+			   CollectiveAlgorithm intraNodeAlgorithm = ALGORITHM_RING);
+
+	[[nodiscard]] static bool isAvailable(CollectiveOperation operation, CollectiveAlgorithm algorithm);
+
+	void setBytes(double bytes);
+
+	[[nodiscard]] double estimate(const std::vector<Node*>& nodes) const;
+
+	[[nodiscard]] std::vector<double> getBytesPerRank(int numRanks) const;
+
+	[[nodiscard]] std::pair<double, double> getIntraNodeBytes(int numNodes, int numGpusPerNode) const;
+
+	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
+				 const simgrid::s4u::BarrierPtr& barrier) const;
+
+};
+
+
+#endif //ELASTISIM_COLLECTIVE_H
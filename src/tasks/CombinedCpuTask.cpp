@@ -10,41 +10,56 @@
 
 #include "CombinedCpuTask.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "Node.h"
 #include "Utility.h"
+#include "Profiler.h"
+#include "Communication.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(CombinedCpuTask, "Messages within the combined CPU task");
 
 CombinedCpuTask::CombinedCpuTask(const std::string& name, const std::string& iterations, bool synchronized,
-								 const std::optional<std::vector<double>>& flops,
+								 bool asynchronous, const std::optional<std::vector<double>>& flops,
 								 const std::optional<std::string>& computationModel, VectorPattern computationPattern,
 								 const std::optional<std::string>& communicationModel,
 								 MatrixPattern communicationPattern, std::optional<std::vector<double>> payloads,
-								 bool coupled) :
-		CombinedTask(name, iterations, synchronized, flops, computationModel, computationPattern, communicationModel,
-					 communicationPattern),
-		payloads(payloads.has_value() ? std::move(payloads.value()) : std::vector<double>()), coupled(coupled) {}
+								 bool coupled, std::optional<Collective> collective) :
+		CombinedTask(name, iterations, synchronized, asynchronous, flops, computationModel, computationPattern,
+					 communicationModel, communicationPattern),
+		payloads(payloads.has_value() ? std::move(payloads.value()) : std::vector<double>()), coupled(coupled),
+		collective(std::move(collective)) {
+	if (asynchronous && (coupled || this->collective.has_value())) {
+		xbt_die("Coupled tasks and collectives synchronize all ranks and can not be asynchronous");
+	}
+}
 
 void CombinedCpuTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 							  simgrid::s4u::BarrierPtr barrier) const {
-	if (coupled && !flops.empty() && !payloads.empty()) {
+	// flow-level communication can not run parallel tasks, there the computation overlaps with the sends instead
+	if (coupled && !flops.empty() && !payloads.empty() && !Communication::usesFlows()) {
+		Profiler::count(COUNT_BARRIER_WAITS);
 		barrier->wait();
 		if (rank == 0) {
 			std::vector<simgrid::s4u::Host*> hosts;
 			const auto& func = [](const Node* node) { return node->getHost(); };
 			std::transform(std::begin(nodes), std::end(nodes), std::back_inserter(hosts), func);
+			Profiler::countActivities(ACTIVITY_PTASK, job->getType());
 			simgrid::s4u::this_actor::parallel_execute(hosts, flops, payloads);
 		}
+		Profiler::count(COUNT_BARRIER_WAITS);
 		barrier->wait();
 	} else {
 		std::vector<simgrid::s4u::ActivityPtr> activities;
 		if (!flops.empty() && flops[rank] > 0) {
 			XBT_INFO("Processing %f FLOPS", flops[rank]);
-			activities.emplace_back(node->getHost()->exec_async(flops[rank]));
+			Profiler::countActivities(ACTIVITY_EXEC, job->getType());
+			activities = node->trackActivities(job, {node->getHost()->exec_async(flops[rank])});
 		}
-		if (!payloads.empty()) {
+		if (collective.has_value()) {
+			collective->execute(node, job, nodes, rank, barrier);
+		} else if (!payloads.empty()) {
 			int numberOfAssignedNodes = nodes.size();
 			int destinationRank = 0;
 			for (const auto& assignedNode: nodes) {
@@ -53,15 +68,24 @@ void CombinedCpuTask::execute(const Node* node, const Job* job, const std::vecto
 					XBT_INFO("Sending %f bytes to %s", payloads[index], assignedNode->getHostName().c_str());
 				}
 			}
+			Profiler::count(COUNT_BARRIER_WAITS);
 			barrier->wait();
-			if (rank == 0) {
+			if (Communication::usesFlows()) {
+				std::vector<simgrid::s4u::ActivityPtr> sends = node->trackActivities(
+						job, Communication::sendRow(node, nodes, payloads, rank, job));
+				for (const auto& activity: sends) {
+					activity->wait();
+				}
+			} else if (rank == 0) {
 				std::vector<simgrid::s4u::Host*> hosts;
 				std::vector<Node*> assignedNodes = nodes;
 				const auto& func = [](const Node* node) { return node->getHost(); };
 				std::transform(std::begin(assignedNodes), std::end(assignedNodes), std::back_inserter(hosts), func);
 				std::vector<double> empty(numberOfAssignedNodes);
+				Profiler::countActivities(ACTIVITY_PTASK, job->getType());
 				simgrid::s4u::this_actor::parallel_execute(hosts, empty, payloads);
 			}
+			Profiler::count(COUNT_BARRIER_WAITS);
 			barrier->wait();
 		}
 		for (const auto& activity: activities) {
@@ -70,10 +94,65 @@ void CombinedCpuTask::execute(const Node* node, const Job* job, const std::vecto
 	}
 }
 
+bool CombinedCpuTask::canExecuteAsync() const {
+	return !coupled && !collective.has_value();
+}
+
+std::vector<simgrid::s4u::ActivityPtr>
+CombinedCpuTask::executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const {
+	std::vector<simgrid::s4u::ActivityPtr> activities;
+	if (!flops.empty() && flops[rank] > 0) {
+		XBT_INFO("Processing %f FLOPS asynchronously", flops[rank]);
+		Profiler::countActivities(ACTIVITY_EXEC, job->getType());
+		activities.emplace_back(node->getHost()->exec_async(flops[rank]));
+	}
+	if (!payloads.empty()) {
+		// posted like non-blocking point-to-point messages, so the ranks are not synchronized
+		std::vector<simgrid::s4u::ActivityPtr> sends = Communication::sendRow(node, nodes, payloads, rank, job);
+		activities.insert(std::end(activities), std::begin(sends), std::end(sends));
+	}
+	return node->trackActivities(job, std::move(activities));
+}
+
+double CombinedCpuTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+										  const std::map<std::string, std::string>& runtimeArguments) const {
+	int numNodes = (int) nodes.size();
+	// the computation overlaps with the communication on every rank, the slowest rank determines the iteration
+	double computation = 0;
+	std::vector<double> computations = getFlops(numNodes, numGpusPerNode, runtimeArguments);
+	for (size_t rank = 0; rank < computations.size() && rank < nodes.size(); ++rank) {
+		computation = std::max(computation, computations[rank] / nodes[rank]->getHost()->get_speed());
+	}
+	double communication = 0;
+	if (collective.has_value()) {
+		Collective candidate = collective.value();
+		if (!communicationModel.empty()) {
+			candidate.setBytes(Utility::evaluateFormula(communicationModel, numNodes, numGpusPerNode,
+														runtimeArguments));
+		}
+		communication = candidate.estimate(nodes);
+	} else {
+		std::vector<double> communications = communicationModel.empty() ? payloads :
+											 Utility::createMatrix(communicationModel, communicationPattern,
+																   numNodes, numGpusPerNode, runtimeArguments);
+		if (communications.size() == nodes.size() * nodes.size()) {
+			for (int rank = 0; rank < numNodes; ++rank) {
+				communication = std::max(communication, Communication::estimateRow(nodes, communications, rank));
+			}
+		}
+	}
+	return std::max(computation, communication);
+}
+
 void
 CombinedCpuTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	CombinedTask::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
-	if (!communicationModel.empty()) {
+	if (communicationModel.empty()) {
+		return;
+	}
+	if (collective.has_value()) {
+		collective->setBytes(Utility::evaluateFormula(communicationModel, numNodes, numGpusPerNode, runtimeArguments));
+	} else {
 		payloads = Utility::createMatrix(communicationModel, communicationPattern, numNodes, numGpusPerNode,
 										 runtimeArguments);
 	}
@@ -13,22 +13,35 @@
 
 
 #include "CombinedTask.h"
+#include "Collective.h"
 
 class CombinedCpuTask : public CombinedTask {
 
 private:
 	std::vector<double> payloads;
 	const bool coupled;
+	std::optional<Collective> collective;
+
+protected:
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
 
 public:
-	CombinedCpuTask(const std::string& name, const std::string& iterations, bool synchronized,
+	CombinedCpuTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 					const std::optional<std::vector<double>>& flops, const std::optional<std::string>& computationModel,
 					VectorPattern computationPattern, const std::optional<std::string>& communicationModel,
-					MatrixPattern communicationPattern, std::optional<std::vector<double>> payloads, bool coupled);
+					MatrixPattern communicationPattern, std::optional<std::vector<double>> payloads, bool coupled,
+					std::optional<Collective> collective);
 
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override;
 
+	[[nodiscard]] bool canExecuteAsync() const override;
+
+	[[nodiscard]] std::vector<simgrid::s4u::ActivityPtr>
+	executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const override;
+
 	void scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) override;
 
 };
@@ -13,34 +13,40 @@
 #include "Gpu.h"
 #include "Job.h"
 #include "Utility.h"
+#include "Profiler.h"
+#include "Communication.h"
 #include <simgrid/s4u.hpp>
+#include <limits>
 #include <utility>
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(CombinedGpuTask, "Messages within the combined GPU task");
 
+void* CombinedGpuTask::callbackPayload;
+
 CombinedGpuTask::CombinedGpuTask(const std::string& name, const std::string& iterations, bool synchronized,
-								 const std::optional<std::vector<double>>& flops,
+								 bool asynchronous, const std::optional<std::vector<double>>& flops,
 								 const std::optional<std::string>& computationModel, VectorPattern computationPattern,
 								 const std::optional<std::string>& communicationModel,
 								 MatrixPattern communicationPattern,
 								 std::optional<std::vector<double>> intraNodeCommunications,
-								 std::optional<std::vector<double>> interNodeCommunications) :
-		CombinedTask(name, iterations, synchronized, flops, computationModel, computationPattern, communicationModel,
-					 communicationPattern),
+								 std::optional<std::vector<double>> interNodeCommunications,
+								 std::optional<Collective> collective) :
+		CombinedTask(name, iterations, synchronized, asynchronous, flops, computationModel, computationPattern,
+					 communicationModel, communicationPattern),
 		intraNodeCommunications(intraNodeCommunications.has_value() ? std::move(intraNodeCommunications.value())
 																	: std::vector<double>()),
 		interNodeCommunications(interNodeCommunications.has_value() ? std::move(interNodeCommunications.value())
-																	: std::vector<double>()) {
+																	: std::vector<double>()),
+		collective(std::move(collective)) {
 	if (intraNodeCommunications.has_value() != interNodeCommunications.has_value()) {
 		xbt_die("Specifying only one of intra- or inter-node communication is invalid.");
 	}
+	if (asynchronous && this->collective.has_value()) {
+		xbt_die("Collectives synchronize all ranks and can not be asynchronous");
+	}
 }
 
-void CombinedGpuTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
-							  simgrid::s4u::BarrierPtr barrier) const {
-
-	std::vector<s4u_Mailbox*> gpuCallbacks;
-	s4u_Mailbox* gpuLinkCallback = s4u_Mailbox::by_name("GPULink@" + node->getHostName());
+int CombinedGpuTask::getNumGpusPerNode(const Node* node, const Job* job) {
 	int numGpusPerNode = job->getExecutingNumGpusPerNode();
 	std::vector<const Gpu*> gpus = node->getGpus();
 	if (numGpusPerNode == 0) {
@@ -49,14 +55,36 @@ void CombinedGpuTask::execute(const Node* node, const Job* job, const std::vecto
 	if (numGpusPerNode > gpus.size()) {
 		xbt_die("Number of required GPUs (%d) higher than number of GPUs on node (%zu)", numGpusPerNode, gpus.size());
 	}
+	return numGpusPerNode;
+}
+
+void CombinedGpuTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
+							  simgrid::s4u::BarrierPtr barrier) const {
+
+	std::vector<s4u_Mailbox*> gpuCallbacks;
+	s4u_Mailbox* gpuLinkCallback = s4u_Mailbox::by_name("GPULink@" + node->getHostName());
+	int numGpusPerNode = getNumGpusPerNode(node, job);
 
 	if (!flops.empty() && flops[rank] > 0) {
 		double flopsPerGpu = flops[rank] / numGpusPerNode;
-		gpuCallbacks = node->execGpuComputationAsync(numGpusPerNode, flopsPerGpu);
+		gpuCallbacks = node->execGpuComputationAsync(job, numGpusPerNode, flopsPerGpu);
+	}
+
+	if (collective.has_value()) {
+		// the computation keeps running on the GPUs while the collective proceeds phase by phase
+		auto [intraNodeBytesBefore, intraNodeBytesAfter] = collective->getIntraNodeBytes((int) nodes.size(),
+																						   numGpusPerNode);
+		if (intraNodeBytesBefore > 0) {
+			node->execGpuTransferAsync(job, intraNodeBytesBefore)->get<void>();
+		}
+		collective->execute(node, job, nodes, rank, barrier);
+		if (intraNodeBytesAfter > 0) {
+			node->execGpuTransferAsync(job, intraNodeBytesAfter)->get<void>();
+		}
 	}
 
 	if (!intraNodeCommunications.empty()) {
-		gpuLinkCallback = node->execGpuTransferAsync(intraNodeCommunications, numGpusPerNode);
+		gpuLinkCallback = node->execGpuTransferAsync(job, intraNodeCommunications, numGpusPerNode);
 	}
 
 	if (!interNodeCommunications.empty()) {
@@ -68,15 +96,24 @@ void CombinedGpuTask::execute(const Node* node, const Job* job, const std::vecto
 				XBT_INFO("Sending %f bytes to %s", interNodeCommunications[index], assignedNode->getHostName().c_str());
 			}
 		}
+		Profiler::count(COUNT_BARRIER_WAITS);
 		barrier->wait();
-		if (rank == 0) {
+		if (Communication::usesFlows()) {
+			std::vector<simgrid::s4u::ActivityPtr> sends = node->trackActivities(
+					job, Communication::sendRow(node, nodes, interNodeCommunications, rank, job));
+			for (const auto& activity: sends) {
+				activity->wait();
+			}
+		} else if (rank == 0) {
 			std::vector<s4u_Host*> hosts;
 			std::vector<Node*> assignedNodes = nodes;
 			auto func = [](const Node* node) { return node->getHost(); };
 			std::transform(std::begin(assignedNodes), std::end(assignedNodes), std::back_inserter(hosts), func);
 			std::vector<double> empty(numberOfAssignedNodes);
+			Profiler::countActivities(ACTIVITY_PTASK, job->getType());
 			simgrid::s4u::this_actor::parallel_execute(hosts, empty, interNodeCommunications);
 		}
+		Profiler::count(COUNT_BARRIER_WAITS);
 		barrier->wait();
 	}
 	for (const auto& gpuCallback: gpuCallbacks) {
@@ -87,10 +124,88 @@ void CombinedGpuTask::execute(const Node* node, const Job* job, const std::vecto
 	}
 }
 
+bool CombinedGpuTask::canExecuteAsync() const {
+	return !collective.has_value();
+}
+
+std::vector<simgrid::s4u::ActivityPtr>
+CombinedGpuTask::executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const {
+	std::vector<simgrid::s4u::ActivityPtr> activities;
+	int numGpusPerNode = getNumGpusPerNode(node, job);
+	// the GPU actors report completion through their callback mailboxes, receiving from them becomes the activity
+	if (!flops.empty() && flops[rank] > 0) {
+		for (const auto& gpuCallback: node->execGpuComputationAsync(job, numGpusPerNode,
+																	flops[rank] / numGpusPerNode)) {
+			activities.push_back(gpuCallback->get_async<void>(&callbackPayload));
+		}
+	}
+	if (!intraNodeCommunications.empty()) {
+		activities.push_back(node->execGpuTransferAsync(job, intraNodeCommunications, numGpusPerNode)
+									 ->get_async<void>(&callbackPayload));
+	}
+	if (!interNodeCommunications.empty()) {
+		std::vector<simgrid::s4u::ActivityPtr> sends = Communication::sendRow(node, nodes, interNodeCommunications,
+																			  rank, job);
+		activities.insert(std::end(activities), std::begin(sends), std::end(sends));
+	}
+	return node->trackActivities(job, std::move(activities));
+}
+
+double CombinedGpuTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+										  const std::map<std::string, std::string>& runtimeArguments) const {
+	int numNodes = (int) nodes.size();
+	if (numGpusPerNode <= 0) {
+		return std::numeric_limits<double>::infinity();
+	}
+	double computation = 0;
+	std::vector<double> computations = getFlops(numNodes, numGpusPerNode, runtimeArguments);
+	for (size_t rank = 0; rank < computations.size() && rank < nodes.size(); ++rank) {
+		const std::vector<const Gpu*>& gpus = nodes[rank]->getGpus();
+		if (numGpusPerNode > gpus.size()) {
+			return std::numeric_limits<double>::infinity();
+		}
+		double flopsPerGpu = computations[rank] / numGpusPerNode;
+		computation = std::max(computation, flopsPerGpu / (double) gpus.front()->getProcessingSpeed());
+	}
+	double gpuToGpuBandwidth = nodes.front()->getGpuToGpuBandwidth();
+	double communication = 0;
+	if (collective.has_value()) {
+		// the intra-node phases enclose the inter-node algorithm, only the computation runs alongside
+		Collective candidate = collective.value();
+		if (!communicationModel.empty()) {
+			candidate.setBytes(Utility::evaluateFormula(communicationModel, numNodes, numGpusPerNode,
+														runtimeArguments));
+		}
+		auto [intraNodeBytesBefore, intraNodeBytesAfter] = candidate.getIntraNodeBytes(numNodes, numGpusPerNode);
+		communication = (intraNodeBytesBefore + intraNodeBytesAfter) / gpuToGpuBandwidth + candidate.estimate(nodes);
+	} else {
+		std::vector<double> intraNode = intraNodeCommunications;
+		std::vector<double> interNode = interNodeCommunications;
+		if (!communicationModel.empty()) {
+			std::tie(intraNode, interNode) = Utility::createMatrices(communicationModel, communicationPattern,
+																	 numNodes, numGpusPerNode, runtimeArguments);
+		}
+		if (intraNode.size() == (size_t) (numGpusPerNode * numGpusPerNode)) {
+			communication = Node::getDominantGpuTransfer(intraNode, numGpusPerNode) / gpuToGpuBandwidth;
+		}
+		if (interNode.size() == nodes.size() * nodes.size()) {
+			for (int rank = 0; rank < numNodes; ++rank) {
+				communication = std::max(communication, Communication::estimateRow(nodes, interNode, rank));
+			}
+		}
+	}
+	return std::max(computation, communication);
+}
+
 void
 CombinedGpuTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	CombinedTask::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
-	if (!communicationModel.empty()) {
+	if (communicationModel.empty()) {
+		return;
+	}
+	if (collective.has_value()) {
+		collective->setBytes(Utility::evaluateFormula(communicationModel, numNodes, numGpusPerNode, runtimeArguments));
+	} else {
 		std::tie(intraNodeCommunications, interNodeCommunications) =
 				Utility::createMatrices(communicationModel, communicationPattern, numNodes, numGpusPerNode,
 										runtimeArguments);
@@ -13,23 +13,39 @@
 
 
 #include "CombinedTask.h"
+#include "Collective.h"
 
 class CombinedGpuTask : public CombinedTask {
 
 private:
 	std::vector<double> intraNodeCommunications;
 	std::vector<double> interNodeCommunications;
+	std::optional<Collective> collective;
+
+	static void* callbackPayload;
+
+	[[nodiscard]] static int getNumGpusPerNode(const Node* node, const Job* job);
+
+protected:
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
 
 public:
-	CombinedGpuTask(const std::string& name, const std::string& iterations, bool synchronized,
+	CombinedGpuTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 					const std::optional<std::vector<double>>& flops, const std::optional<std::string>& computationModel,
 					VectorPattern computationPattern, const std::optional<std::string>& communicationModel,
 					MatrixPattern communicationPattern, std::optional<std::vector<double>> intraNodeCommunications,
-					std::optional<std::vector<double>> interNodeCommunications);
+					std::optional<std::vector<double>> interNodeCommunications, std::optional<Collective> collective);
 
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override;
 
+	[[nodiscard]] bool canExecuteAsync() const override;
+
+	[[nodiscard]] std::vector<simgrid::s4u::ActivityPtr>
+	executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const override;
+
 	void scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) override;
 
 };
@@ -16,16 +16,28 @@
 #include "Utility.h"
 
 CombinedTask::CombinedTask(const std::string& name, const std::string& iterations, bool synchronized,
-						   std::optional<std::vector<double>> flops, std::optional<std::string> computationModel,
-						   VectorPattern computationPattern, std::optional<std::string> communicationModel,
-						   MatrixPattern communicationPattern) :
-		Task(name, iterations, synchronized),
+						   bool asynchronous, std::optional<std::vector<double>> flops,
+						   std::optional<std::string> computationModel, VectorPattern computationPattern,
+						   std::optional<std::string> communicationModel, MatrixPattern communicationPattern) :
+		Task(name, iterations, synchronized), asynchronous(asynchronous),
 		flops(flops.has_value() ? std::move(flops.value()) : std::vector<double>()),
 		computationModel(computationModel.has_value() ? std::move(computationModel.value()) : ""),
 		computationPattern(computationPattern),
 		communicationModel(communicationModel.has_value() ? std::move(communicationModel.value()) : ""),
 		communicationPattern(communicationPattern) {}
 
+bool CombinedTask::isAsynchronous() const {
+	return asynchronous;
+}
+
+std::vector<double> CombinedTask::getFlops(int numNodes, int numGpusPerNode,
+										  const std::map<std::string, std::string>& runtimeArguments) const {
+	if (computationModel.empty()) {
+		return flops;
+	}
+	return Utility::createVector(computationModel, computationPattern, numNodes, numGpusPerNode, runtimeArguments);
+}
+
 void
 CombinedTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	Task::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
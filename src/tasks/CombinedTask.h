@@ -16,6 +16,9 @@
 
 class CombinedTask : public Task {
 
+private:
+	const bool asynchronous;
+
 protected:
 	std::vector<double> flops;
 	const std::string computationModel;
@@ -23,12 +26,17 @@ protected:
 	const std::string communicationModel;
 	const MatrixPattern communicationPattern;
 
+	[[nodiscard]] std::vector<double>
+	getFlops(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) const;
+
 public:
-	CombinedTask(const std::string& name, const std::string& iterations, bool synchronized,
+	CombinedTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 				 std::optional<std::vector<double>> flops, std::optional<std::string> computationModel,
 				 VectorPattern computationPattern, std::optional<std::string> communicationModel,
 				 MatrixPattern communicationPattern);
 
+	[[nodiscard]] bool isAsynchronous() const override;
+
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override = 0;
 
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "Communication.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <xbt/asserts.h>
+#include "Node.h"
+#include "Job.h"
+#include "Configuration.h"
+#include "Profiler.h"
+
+bool Communication::flows = false;
+
+void Communication::init() {
+	flows = Configuration::exists("communication_model") &&
+			Configuration::get("communication_model").get<std::string>() == "flows";
+	if (flows) {
+		std::string networkModel = "LV08";
+		if (Configuration::exists("network_model")) {
+			networkModel = Configuration::get("network_model");
+		}
+		simgrid::s4u::Engine::set_config("network/model:" + networkModel);
+		// the ptask host models bring their own network model, which would silently replace the configured one
+		if (Configuration::exists("host_model")) {
+			std::string hostModel = Configuration::get("host_model");
+			if (hostModel.rfind("ptask_", 0) == 0) {
+				xbt_die("Host model %s ignores the network model of flow-level communication", hostModel.c_str());
+			}
+			simgrid::s4u::Engine::set_config("host/model:" + hostModel);
+		}
+	} else {
+		simgrid::s4u::Engine::set_config("host/model:ptask_L07");
+	}
+}
+
+bool Communication::usesFlows() {
+	return flows;
+}
+
+simgrid::s4u::ActivityPtr Communication::send(s4u_Host* source, s4u_Host* destination, double bytes, const Job* job) {
+	Profiler::countActivities(ACTIVITY_COMM, job->getType());
+	return simgrid::s4u::Comm::sendto_async(source, destination, (uint64_t) bytes);
+}
+
+double Communication::estimate(s4u_Host* source, s4u_Host* destination, double bytes) {
+	if (source == destination || bytes <= 0) {
+		return 0;
+	}
+	// latency plus size over the bottleneck bandwidth of the route, as if no other flow shared it
+	std::vector<simgrid::s4u::Link*> links;
+	double latency = 0;
+	source->route_to(destination, links, &latency);
+	double bandwidth = std::numeric_limits<double>::infinity();
+	for (const auto& link: links) {
+		bandwidth = std::min(bandwidth, link->get_bandwidth());
+	}
+	return latency + bytes / bandwidth;
+}
+
+double Communication::estimateRow(const std::vector<Node*>& nodes, const std::vector<double>& payloads, int rank) {
+	double time = 0;
+	size_t numNodes = nodes.size();
+	for (size_t destination = 0; destination < numNodes; ++destination) {
+		time = std::max(time, estimate(nodes[rank]->getHost(), nodes[destination]->getHost(),
+									   payloads[rank * numNodes + destination]));
+	}
+	return time;
+}
+
+std::vector<simgrid::s4u::ActivityPtr>
+Communication::sendRow(const Node* node, const std::vector<Node*>& nodes, const std::vector<double>& payloads,
+					   int rank, const Job* job) {
+	std::vector<simgrid::s4u::ActivityPtr> activities;
+	size_t numNodes = nodes.size();
+	s4u_Host* source = node->getHost();
+	for (size_t destination = 0; destination < numNodes; ++destination) {
+		double bytes = payloads[rank * numNodes + destination];
+		if (bytes > 0) {
+			activities.push_back(send(source, nodes[destination]->getHost(), bytes, job));
+		}
+	}
+	return activities;
+}
+
+std::vector<simgrid::s4u::ActivityPtr>
+Communication::redistribute(const std::vector<Node*>& sources, const std::vector<Node*>& destinations, int rank,
+							double bytes, const Job* job) {
+	std::vector<simgrid::s4u::ActivityPtr> activities;
+	size_t numSources = sources.size();
+	if (numSources == 0 || bytes <= 0) {
+		return activities;
+	}
+	// block distributions before and after: the rank receives the overlap of its new block with each old block
+	double begin = bytes * rank / destinations.size();
+	double end = bytes * (rank + 1) / destinations.size();
+	s4u_Host* destination = destinations[rank]->getHost();
+	size_t first = std::min((size_t) (begin * numSources / bytes), numSources - 1);
+	for (size_t source = first > 0 ? first - 1 : 0; source < numSources; ++source) {
+		double sourceBegin = bytes * source / numSources;
+		if (sourceBegin >= end) {
+			break;
+		}
+		double overlap = std::min(end, bytes * (source + 1) / numSources) - std::max(begin, sourceBegin);
+		s4u_Host* sourceHost = sources[source]->getHost();
+		if (overlap > 0 && sourceHost != destination) {
+			activities.push_back(send(sourceHost, destination, overlap, job));
+		}
+	}
+	return activities;
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_COMMUNICATION_H
+#define ELASTISIM_COMMUNICATION_H
+
+
+#include <vector>
+#include <simgrid/s4u.hpp>
+
+class Node;
+
+class Job;
+
+// Selects how communication is simulated. By default, every pattern runs as one parallel task over all involved
+// hosts under the ptask_L07 host model. With the communication_model "flows", patterns are lowered to point-to-point
+// comms under a flow-level network model (network_model, LV08 by default), which only costs the non-zero entries.
+// The host model stays a non-ptask one so that the network model applies, hence coupled tasks and the striped I/O
+// tasks are lowered to concurrent execs and comms as well.
+class Communication {
+
+private:
+	static bool flows;
+
+public:
+	static void init();
+
+	[[nodiscard]] static bool usesFlows();
+
+	[[nodiscard]] static simgrid::s4u::ActivityPtr
+	send(s4u_Host* source, s4u_Host* destination, double bytes, const Job* job);
+
+	[[nodiscard]] static std::vector<simgrid::s4u::ActivityPtr>
+	sendRow(const Node* node, const std::vector<Node*>& nodes, const std::vector<double>& payloads, int rank,
+			const Job* job);
+
+	[[nodiscard]] static double estimate(s4u_Host* source, s4u_Host* destination, double bytes);
+
+	[[nodiscard]] static double
+	estimateRow(const std::vector<Node*>& nodes, const std::vector<double>& payloads, int rank);
+
+	[[nodiscard]] static std::vector<simgrid::s4u::ActivityPtr>
+	redistribute(const std::vector<Node*>& sources, const std::vector<Node*>& destinations, int rank, double bytes,
+				 const Job* job);
+
+};
+
+
+#endif //ELASTISIM_COMMUNICATION_H
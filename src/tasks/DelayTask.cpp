@@ -10,6 +10,7 @@
 
 #include "DelayTask.h"
 
+#include <algorithm>
 #include <utility>
 #include "Utility.h"
 
@@ -21,6 +22,20 @@ DelayTask::DelayTask(const std::string& name, const std::string& iterations, boo
 		delayModel(delayModel.has_value() ? std::move(delayModel.value()) : ""),
 		delayPattern(delayPattern) {}
 
+double DelayTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+									const std::map<std::string, std::string>& runtimeArguments) const {
+	std::vector<double> candidateDelays = delays;
+	if (!delayModel.empty()) {
+		candidateDelays = Utility::createVector(delayModel, delayPattern, (int) nodes.size(), numGpusPerNode,
+												runtimeArguments);
+	}
+	double delay = 0;
+	for (size_t rank = 0; rank < candidateDelays.size() && rank < nodes.size(); ++rank) {
+		delay = std::max(delay, candidateDelays[rank]);
+	}
+	return delay;
+}
+
 void DelayTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	Task::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
 	delays = Utility::createVector(delayModel, delayPattern, numNodes, numGpusPerNode, runtimeArguments);
@@ -21,6 +21,10 @@ protected:
 	const std::string delayModel;
 	const VectorPattern delayPattern;
 
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
+
 public:
 	DelayTask(const std::string& name, const std::string& iterations, bool synchronized,
 			  std::optional<std::vector<double>> delays, std::optional<std::string> delayModel,
@@ -10,8 +10,12 @@
 
 #include "IoTask.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
+#include "Node.h"
 #include "Utility.h"
+#include "Communication.h"
 
 IoTask::IoTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 			   std::optional<std::vector<double>> ioSizes, std::optional<std::string> ioModel,
@@ -24,6 +28,41 @@ bool IoTask::isAsynchronous() const {
 	return asynchronous;
 }
 
+bool IoTask::canExecuteAsync() const {
+	return true;
+}
+
+std::vector<double> IoTask::getIoSizes(int numNodes, int numGpusPerNode,
+									   const std::map<std::string, std::string>& runtimeArguments) const {
+	if (ioModel.empty()) {
+		return ioSizes;
+	}
+	return Utility::createVector(ioModel, ioPattern, numNodes, numGpusPerNode, runtimeArguments);
+}
+
+double IoTask::estimateBurstBuffer(const std::vector<Node*>& nodes, const std::vector<double>& sizes, bool read) {
+	double time = 0;
+	size_t numNodes = nodes.size();
+	for (size_t rank = 0; rank < sizes.size() && rank < numNodes; ++rank) {
+		const Node* node = nodes[rank];
+		double bytes = sizes[rank];
+		if (node->getType() == COMPUTE_NODE_WITH_WIDE_STRIPED_BB) {
+			// the stripes on all assigned nodes move in parallel, each remote one over its own route
+			bytes /= (double) numNodes;
+			if (numNodes > 1) {
+				time = std::max(time, Communication::estimate(nodes[(rank + 1) % numNodes]->getHost(),
+															  node->getHost(), bytes));
+			}
+		} else if (node->getType() != COMPUTE_NODE_WITH_BB) {
+			return std::numeric_limits<double>::infinity();
+		}
+		s4u_Disk* burstBuffer = node->getNodeLocalBurstBuffer();
+		double bandwidth = read ? burstBuffer->get_read_bandwidth() : burstBuffer->get_write_bandwidth();
+		time = std::max(time, bytes / bandwidth);
+	}
+	return time;
+}
+
 void IoTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	Task::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
 	ioSizes = Utility::createVector(ioModel, ioPattern, numNodes, numGpusPerNode, runtimeArguments);
@@ -24,12 +24,20 @@ protected:
 	const std::string ioModel;
 	const VectorPattern ioPattern;
 
+	[[nodiscard]] std::vector<double>
+	getIoSizes(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) const;
+
+	[[nodiscard]] static double
+	estimateBurstBuffer(const std::vector<Node*>& nodes, const std::vector<double>& sizes, bool read);
+
 public:
 	IoTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 		   std::optional<std::vector<double>> ioSizes, std::optional<std::string> ioModel, VectorPattern ioPattern);
 
 	[[nodiscard]] bool isAsynchronous() const override;
 
+	[[nodiscard]] bool canExecuteAsync() const override;
+
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override = 0;
 
@@ -10,6 +10,7 @@
 
 #include "PfsReadTask.h"
 
+#include <utility>
 #include <simgrid/s4u.hpp>
 #include "Node.h"
 #include "Job.h"
@@ -18,8 +19,9 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(PfsReadTask, "Messages within the PFS read task");
 
 PfsReadTask::PfsReadTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 						 const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
-						 VectorPattern ioPattern) :
-		IoTask(name, iterations, synchronized, asynchronous, ioSizes, ioModel, ioPattern) {}
+						 VectorPattern ioPattern, PfsStriping striping) :
+		PfsTask(name, iterations, synchronized, asynchronous, ioSizes, ioModel, ioPattern, true,
+				std::move(striping)) {}
 
 void PfsReadTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 						  simgrid::s4u::BarrierPtr barrier) const {
@@ -35,18 +37,6 @@ PfsReadTask::executeAsync(const Node* node, const Job* job,
 	if (ioSizes[rank] > 0) {
 		XBT_INFO("Reading %f bytes from PFS", ioSizes[rank]);
 	}
-	std::vector<s4u_Host*> hosts = {node->getHost()};
-	std::vector<s4u_Host*> pfsHosts = node->getPfsHosts();
-	hosts.insert(std::end(hosts), std::begin(pfsHosts), std::end(pfsHosts));
-	size_t numHosts = hosts.size();
-	std::vector<double> empty(numHosts);
-	std::vector<double> payloads(numHosts * numHosts, 0);
-	double payloadPerHost = ioSizes[rank] / (numHosts - 1);
-	for (int i = numHosts; i < numHosts * numHosts; i += numHosts) {
-		payloads[i] = payloadPerHost;
-	}
-	simgrid::s4u::ActivityPtr activity = simgrid::s4u::this_actor::exec_init(hosts, empty, payloads);
-	activity->start();
-	return {activity};
+	return startTransfers(node, job, rank);
 }
 
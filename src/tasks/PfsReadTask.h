@@ -13,14 +13,14 @@
 
 
 #include <vector>
-#include "IoTask.h"
+#include "PfsTask.h"
 
-class PfsReadTask : public IoTask {
+class PfsReadTask : public PfsTask {
 
 public:
 	PfsReadTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 				const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
-				VectorPattern ioPattern);
+				VectorPattern ioPattern, PfsStriping striping);
 
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override;
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "PfsTask.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <simgrid/s4u.hpp>
+#include <xbt/asserts.h>
+#include "Node.h"
+#include "Job.h"
+#include "Profiler.h"
+#include "Communication.h"
+#include "Utility.h"
+
+PfsTask::PfsTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
+				 const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
+				 VectorPattern ioPattern, bool read, PfsStriping striping) :
+		IoTask(name, iterations, synchronized, asynchronous, ioSizes, ioModel, ioPattern), read(read),
+		striping(std::move(striping)) {}
+
+std::vector<double> PfsTask::distribute(double offset, double size, int stripeCount) const {
+	std::vector<double> bytes(stripeCount);
+	if (striping.stripeSize <= 0) {
+		std::fill(bytes.begin(), bytes.end(), size / stripeCount);
+		return bytes;
+	}
+	// whole rounds over all stripes first, then the remainder starting at the stripe the offset falls into
+	double roundSize = striping.stripeSize * stripeCount;
+	double rounds = std::floor(size / roundSize);
+	std::fill(bytes.begin(), bytes.end(), rounds * striping.stripeSize);
+	double remaining = size - rounds * roundSize;
+	double position = std::fmod(offset, roundSize);
+	while (remaining > 0) {
+		int stripe = std::min((int) (position / striping.stripeSize), stripeCount - 1);
+		double chunk = std::min(remaining, (stripe + 1) * striping.stripeSize - position);
+		if (chunk <= 0) {
+			// rounding left the position on the boundary to the next stripe
+			position = std::fmod((stripe + 1) * striping.stripeSize, roundSize);
+			continue;
+		}
+		bytes[stripe] += chunk;
+		remaining -= chunk;
+		position = std::fmod(position + chunk, roundSize);
+	}
+	return bytes;
+}
+
+const PfsTask::Transfer& PfsTask::getTransfer(const Node* node, const Job* job, int rank) const {
+	auto it = transfers.find(node);
+	if (it != transfers.end() && it->second.rank == rank) {
+		return it->second;
+	}
+
+	const std::vector<s4u_Host*>& pfsHosts = node->getPfsHosts();
+	int numTargets = (int) pfsHosts.size();
+	if (numTargets == 0) {
+		xbt_die("No PFS targets available on node %s", node->getHostName().c_str());
+	}
+	int stripeCount = striping.stripeCount > 0 ? std::min(striping.stripeCount, numTargets) : numTargets;
+	size_t firstTarget;
+	double offset = 0;
+	if (striping.selection == JOB_HASH) {
+		const std::string& file = striping.file.empty() ? getName() : striping.file;
+		firstTarget = Utility::hash(std::to_string(job->getId()) + "/" + file) % numTargets;
+		for (int i = 0; i < rank; ++i) {
+			offset += ioSizes[i];
+		}
+	} else {
+		firstTarget = ((size_t) rank * stripeCount) % numTargets;
+	}
+	std::vector<double> bytes = distribute(offset, ioSizes[rank], stripeCount);
+
+	Transfer& transfer = transfers[node];
+	transfer.rank = rank;
+	size_t numHosts = stripeCount + 1;
+	transfer.hosts.clear();
+	transfer.hosts.reserve(numHosts);
+	transfer.hosts.push_back(node->getHost());
+	for (int i = 0; i < stripeCount; ++i) {
+		transfer.hosts.push_back(pfsHosts[(firstTarget + i) % numTargets]);
+	}
+	transfer.flops.assign(numHosts, 0);
+	transfer.payloads.assign(numHosts * numHosts, 0);
+	// reads flow from the targets to the node (first column), writes from the node to the targets (first row)
+	for (size_t i = 1; i < numHosts; ++i) {
+		transfer.payloads[read ? i * numHosts : i] = bytes[i - 1];
+	}
+	return transfer;
+}
+
+std::vector<simgrid::s4u::ActivityPtr> PfsTask::startTransfers(const Node* node, const Job* job, int rank) const {
+	const Transfer& transfer = getTransfer(node, job, rank);
+	if (Communication::usesFlows()) {
+		std::vector<simgrid::s4u::ActivityPtr> activities;
+		size_t numHosts = transfer.hosts.size();
+		for (size_t i = 1; i < numHosts; ++i) {
+			double bytes = transfer.payloads[read ? i * numHosts : i];
+			if (bytes > 0) {
+				activities.push_back(read ? Communication::send(transfer.hosts[i], node->getHost(), bytes, job)
+										  : Communication::send(node->getHost(), transfer.hosts[i], bytes, job));
+			}
+		}
+		return node->trackActivities(job, std::move(activities));
+	}
+	Profiler::countActivities(ACTIVITY_PTASK, job->getType());
+	simgrid::s4u::ActivityPtr activity = simgrid::s4u::this_actor::exec_init(transfer.hosts, transfer.flops,
+																			 transfer.payloads);
+	activity->start();
+	return node->trackActivities(job, {activity});
+}
+
+double PfsTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+								  const std::map<std::string, std::string>& runtimeArguments) const {
+	std::vector<double> sizes = getIoSizes((int) nodes.size(), numGpusPerNode, runtimeArguments);
+	double time = 0;
+	double offset = 0;
+	for (size_t rank = 0; rank < sizes.size() && rank < nodes.size(); ++rank) {
+		const std::vector<s4u_Host*>& pfsHosts = nodes[rank]->getPfsHosts();
+		int numTargets = (int) pfsHosts.size();
+		if (numTargets == 0) {
+			return std::numeric_limits<double>::infinity();
+		}
+		int stripeCount = striping.stripeCount > 0 ? std::min(striping.stripeCount, numTargets) : numTargets;
+		// the first target of a shared file depends on the job, all targets are assumed to be equally fast
+		size_t firstTarget = striping.selection == JOB_HASH ? 0 : (rank * stripeCount) % numTargets;
+		std::vector<double> bytes = distribute(striping.selection == JOB_HASH ? offset : 0, sizes[rank],
+											   stripeCount);
+		offset += sizes[rank];
+		s4u_Host* host = nodes[rank]->getHost();
+		for (int i = 0; i < stripeCount; ++i) {
+			s4u_Host* target = pfsHosts[(firstTarget + i) % numTargets];
+			time = std::max(time, read ? Communication::estimate(target, host, bytes[i])
+									   : Communication::estimate(host, target, bytes[i]));
+		}
+	}
+	return time;
+}
+
+void PfsTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
+	IoTask::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
+	transfers.clear();
+}
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_PFSTASK_H
+#define ELASTISIM_PFSTASK_H
+
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "IoTask.h"
+
+enum StripeSelection {
+	ROUND_ROBIN,
+	JOB_HASH
+};
+
+// Lustre-like file layout: stripes of stripeSize bytes are placed round-robin on stripeCount of the node's PFS
+// targets. A stripe count of zero uses all targets, a stripe size of zero spreads the bytes evenly. With ROUND_ROBIN,
+// every rank writes its own file whose first target rotates with the rank. With JOB_HASH, all ranks share one file
+// whose first target is hashed from the job and file, each rank covering the contiguous range behind lower ranks.
+struct PfsStriping {
+	int stripeCount = 0;
+	double stripeSize = 0;
+	StripeSelection selection = ROUND_ROBIN;
+	std::string file;
+};
+
+class PfsTask : public IoTask {
+
+private:
+	struct Transfer {
+		int rank;
+		std::vector<s4u_Host*> hosts;
+		std::vector<double> flops;
+		std::vector<double> payloads;
+	};
+
+	const bool read;
+	const PfsStriping striping;
+	mutable std::unordered_map<const Node*, Transfer> transfers;
+
+	[[nodiscard]] std::vector<double> distribute(double offset, double size, int stripeCount) const;
+
+	[[nodiscard]] const Transfer& getTransfer(const Node* node, const Job* job, int rank) const;
+
+protected:
+	PfsTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
+			const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
+			VectorPattern ioPattern, bool read, PfsStriping striping);
+
+	[[nodiscard]] std::vector<simgrid::s4u::ActivityPtr>
+	startTransfers(const Node* node, const Job* job, int rank) const;
+
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
+
+public:
+	void scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) override;
+
+};
+
+
+#endif //ELASTISIM_PFSTASK_H
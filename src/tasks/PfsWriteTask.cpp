@@ -10,6 +10,7 @@
 
 #include "PfsWriteTask.h"
 
+#include <utility>
 #include <simgrid/s4u.hpp>
 #include "Node.h"
 #include "Job.h"
@@ -19,8 +20,9 @@ XBT_LOG_NEW_DEFAULT_CATEGORY(PfsWriteTask, "Messages within the PFS write task")
 
 PfsWriteTask::PfsWriteTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 						   const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
-						   VectorPattern ioPattern) :
-		IoTask(name, iterations, synchronized, asynchronous, ioSizes, ioModel, ioPattern) {}
+						   VectorPattern ioPattern, PfsStriping striping) :
+		PfsTask(name, iterations, synchronized, asynchronous, ioSizes, ioModel, ioPattern, false,
+				std::move(striping)) {}
 
 void PfsWriteTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 						   simgrid::s4u::BarrierPtr barrier) const {
@@ -35,17 +37,5 @@ PfsWriteTask::executeAsync(const Node* node, const Job* job, const std::vector<N
 	if (ioSizes[rank] > 0) {
 		XBT_INFO("Writing %f bytes to PFS", ioSizes[rank]);
 	}
-	std::vector<s4u_Host*> hosts = {node->getHost()};
-	std::vector<s4u_Host*> pfsHosts = node->getPfsHosts();
-	hosts.insert(std::end(hosts), std::begin(pfsHosts), std::end(pfsHosts));
-	size_t numHosts = hosts.size();
-	std::vector<double> empty(numHosts);
-	std::vector<double> payloads(numHosts * numHosts, 0);
-	double payloadPerHost = ioSizes[rank] / (numHosts - 1);
-	for (int i = 1; i < numHosts; ++i) {
-		payloads[i] = payloadPerHost;
-	}
-	simgrid::s4u::ActivityPtr activity = simgrid::s4u::this_actor::exec_init(hosts, empty, payloads);
-	activity->start();
-	return {activity};
+	return startTransfers(node, job, rank);
 }
@@ -12,14 +12,14 @@
 #define ELASTISIM_PFSWRITETASK_H
 
 #include <vector>
-#include "IoTask.h"
+#include "PfsTask.h"
 
-class PfsWriteTask : public IoTask {
+class PfsWriteTask : public PfsTask {
 
 public:
 	PfsWriteTask(const std::string& name, const std::string& iterations, bool synchronized, bool asynchronous,
 				 const std::optional<std::vector<double>>& ioSizes, const std::optional<std::string>& ioModel,
-				 VectorPattern ioPattern);
+				 VectorPattern ioPattern, PfsStriping striping);
 
 	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 				 simgrid::s4u::BarrierPtr barrier) const override;
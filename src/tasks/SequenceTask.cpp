@@ -15,6 +15,7 @@
 #include "Job.h"
 #include "Node.h"
 #include "Utility.h"
+#include "Profiler.h"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(SequenceTask, "Messages within the Sequence Task");
 
@@ -31,11 +32,17 @@ void SequenceTask::execute(const Node* node, const Job* job, const std::vector<N
 		for (int i = 0; i < iterations; ++i) {
 			double iterationStart = Utility::logIterationStart(iterations, i);
 			if (task->isSynchronized()) {
+				Profiler::count(COUNT_BARRIER_WAITS);
 				barrier->wait();
 			}
 			if (task->isAsynchronous()) {
 				std::vector<simgrid::s4u::ActivityPtr> activities = task->executeAsync(node, job, nodes, rank);
 				asyncActivities.insert(std::end(asyncActivities), std::begin(activities), std::end(activities));
+			} else if (task->waitsForAsyncActivities()) {
+				for (const auto& activity: asyncActivities) {
+					activity->wait();
+				}
+				asyncActivities.clear();
 			} else {
 				task->execute(node, job, nodes, rank, barrier);
 			}
@@ -48,6 +55,15 @@ void SequenceTask::execute(const Node* node, const Job* job, const std::vector<N
 	}
 }
 
+double SequenceTask::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+									   const std::map<std::string, std::string>& runtimeArguments) const {
+	double time = 0;
+	for (const auto& task: tasks) {
+		time += task->estimate(nodes, numGpusPerNode, runtimeArguments);
+	}
+	return time;
+}
+
 void
 SequenceTask::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	Task::scaleTo(numNodes, numGpusPerNode, runtimeArguments);
@@ -23,6 +23,11 @@ class SequenceTask : public Task {
 private:
 	std::deque<std::unique_ptr<Task>> tasks;
 
+protected:
+	[[nodiscard]] double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const override;
+
 public:
 	SequenceTask(const std::string& name, const std::string& iterations, bool synchronized,
 				 std::deque<std::unique_ptr<Task>> tasks);
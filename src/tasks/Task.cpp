@@ -38,6 +38,14 @@ bool Task::isAsynchronous() const {
 	return false;
 }
 
+bool Task::waitsForAsyncActivities() const {
+	return false;
+}
+
+bool Task::canExecuteAsync() const {
+	return false;
+}
+
 std::vector<simgrid::s4u::ActivityPtr>
 Task::executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const {
 	xbt_die("Task does not support asynchronous execution");
@@ -46,3 +54,16 @@ Task::executeAsync(const Node* node, const Job* job, const std::vector<Node*>& n
 void Task::scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments) {
 	iterations = (int) Utility::evaluateFormula(iterationModel, numNodes, numGpusPerNode, runtimeArguments);
 }
+
+double Task::estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+							   const std::map<std::string, std::string>& runtimeArguments) const {
+	return 0;
+}
+
+double Task::estimate(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const {
+	// models are evaluated for the given configuration, the scaled state of the executing job stays untouched
+	int numIterations = (int) Utility::evaluateFormula(iterationModel, (int) nodes.size(), numGpusPerNode,
+													   runtimeArguments);
+	return numIterations * estimateIteration(nodes, numGpusPerNode, runtimeArguments);
+}
@@ -11,6 +11,8 @@
 #ifndef ELASTISIM_TASK_H
 #define ELASTISIM_TASK_H
 
+#include <map>
+#include <string>
 #include <vector>
 #include <optional>
 #include <simgrid/s4u.hpp>
@@ -47,6 +49,11 @@ private:
 	int iterations;
 	const bool synchronized;
 
+protected:
+	[[nodiscard]] virtual double
+	estimateIteration(const std::vector<Node*>& nodes, int numGpusPerNode,
+					  const std::map<std::string, std::string>& runtimeArguments) const;
+
 public:
 	Task(std::string name, std::string iterationModel, bool synchronized);
 
@@ -62,6 +69,10 @@ public:
 
 	[[nodiscard]] virtual bool isAsynchronous() const;
 
+	[[nodiscard]] virtual bool waitsForAsyncActivities() const;
+
+	[[nodiscard]] virtual bool canExecuteAsync() const;
+
 	virtual void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
 						 simgrid::s4u::BarrierPtr barrier) const = 0;
 
@@ -69,6 +80,9 @@ public:
 	executeAsync(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank) const;
 
 	virtual void scaleTo(int numNodes, int numGpusPerNode, const std::map<std::string, std::string>& runtimeArguments);
+
+	[[nodiscard]] double estimate(const std::vector<Node*>& nodes, int numGpusPerNode,
+								  const std::map<std::string, std::string>& runtimeArguments) const;
 };
 
 
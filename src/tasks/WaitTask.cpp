@@ -0,0 +1,23 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "WaitTask.h"
+
+WaitTask::WaitTask(const std::string& name, const std::string& iterations, bool synchronized) :
+		Task(name, iterations, synchronized) {}
+
+bool WaitTask::waitsForAsyncActivities() const {
+	return true;
+}
+
+void WaitTask::execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
+					   simgrid::s4u::BarrierPtr barrier) const {
+	// the executing application or sequence owns the pending activities and waits for them instead
+}
@@ -0,0 +1,31 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_WAITTASK_H
+#define ELASTISIM_WAITTASK_H
+
+
+#include "Task.h"
+
+// Completes the asynchronous tasks issued before it on the same rank, like MPI_Waitall for non-blocking operations.
+class WaitTask : public Task {
+
+public:
+	WaitTask(const std::string& name, const std::string& iterations, bool synchronized);
+
+	[[nodiscard]] bool waitsForAsyncActivities() const override;
+
+	void execute(const Node* node, const Job* job, const std::vector<Node*>& nodes, int rank,
+				 simgrid::s4u::BarrierPtr barrier) const override;
+
+};
+
+
+#endif //ELASTISIM_WAITTASK_H
@@ -0,0 +1,364 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "Profiler.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+#include <simgrid/s4u.hpp>
+#include "Configuration.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(Profiler, "Messages within the profiler");
+
+bool Profiler::enabled = false;
+std::array<std::atomic<long long>, NUM_PROFILING_CATEGORIES> Profiler::durations{};
+std::array<std::atomic<long long>, NUM_PROFILING_COUNTERS> Profiler::counters{};
+std::map<InvocationType, Profiler::SchedulingStatistics> Profiler::schedulingStatistics;
+std::ofstream Profiler::schedulingTimings;
+std::array<std::array<long long, ADAPTIVE + 1>, NUM_ACTIVITY_CATEGORIES> Profiler::activities{};
+double Profiler::reportInterval = 10;
+bool Profiler::throughputStarted = false;
+std::chrono::steady_clock::time_point Profiler::lastReport;
+double Profiler::lastReportClock = 0;
+long long Profiler::lastReportEvents = 0;
+std::string Profiler::throughput;
+
+std::string Profiler::asString(ProfilingCategory category) {
+	switch (category) {
+		case PROFILE_PLATFORM:
+			return "platform";
+		case PROFILE_PARSING:
+			return "parsing";
+		case PROFILE_MODEL_EVALUATION:
+			return "model_evaluation";
+		case PROFILE_SERIALIZATION:
+			return "serialization";
+		case PROFILE_SCHEDULING:
+			return "scheduling";
+		case PROFILE_SIMULATION:
+			return "simulation";
+		default:
+			xbt_die("Unknown profiling category");
+	}
+}
+
+std::string Profiler::asString(ProfilingCounter counter) {
+	switch (counter) {
+		case COUNT_EVENTS:
+			return "events";
+		case COUNT_SCHEDULING_INVOCATIONS:
+			return "scheduling_invocations";
+		case COUNT_MODEL_EVALUATIONS:
+			return "model_evaluations";
+		case COUNT_APPLICATION_ACTORS:
+			return "application_actors";
+		case COUNT_GPU_ACTORS:
+			return "gpu_actors";
+		case COUNT_GPU_LINK_ACTORS:
+			return "gpu_link_actors";
+		case COUNT_WALLTIME_MONITOR_ACTORS:
+			return "walltime_monitor_actors";
+		case COUNT_BARRIER_WAITS:
+			return "barrier_waits";
+		default:
+			xbt_die("Unknown profiling counter");
+	}
+}
+
+std::string Profiler::asString(SchedulingStage stage) {
+	switch (stage) {
+		case STAGE_BUILD:
+			return "build";
+		case STAGE_DUMP:
+			return "dump";
+		case STAGE_SEND:
+			return "send";
+		case STAGE_WAIT:
+			return "wait";
+		case STAGE_PARSE:
+			return "parse";
+		case STAGE_APPLY:
+			return "apply";
+		case NUM_SCHEDULING_STAGES:
+			return "total";
+		default:
+			xbt_die("Unknown scheduling stage");
+	}
+}
+
+std::string Profiler::asString(InvocationType invocationType) {
+	switch (invocationType) {
+		case INVOKE_PERIODIC:
+			return "periodic";
+		case INVOKE_JOB_SUBMIT:
+			return "job_submit";
+		case INVOKE_JOB_COMPLETED:
+			return "job_completed";
+		case INVOKE_JOB_KILLED:
+			return "job_killed";
+		case INVOKE_SCHEDULING_POINT:
+			return "scheduling_point";
+		case INVOKE_EVOLVING_REQUEST:
+			return "evolving_request";
+		case INVOKE_RECONFIGURATION:
+			return "reconfiguration";
+		default:
+			xbt_die("Unknown invocation type");
+	}
+}
+
+std::string Profiler::asString(ActivityCategory category) {
+	switch (category) {
+		case ACTIVITY_EXEC:
+			return "exec";
+		case ACTIVITY_PTASK:
+			return "ptask";
+		case ACTIVITY_COMM:
+			return "comm";
+		case ACTIVITY_IO:
+			return "io";
+		default:
+			xbt_die("Unknown activity category");
+	}
+}
+
+std::string Profiler::asString(JobType jobType) {
+	switch (jobType) {
+		case RIGID:
+			return "rigid";
+		case MOLDABLE:
+			return "moldable";
+		case MALLEABLE:
+			return "malleable";
+		case EVOLVING:
+			return "evolving";
+		case ADAPTIVE:
+			return "adaptive";
+		default:
+			xbt_die("Unknown job type");
+	}
+}
+
+void Profiler::init() {
+	enabled = Configuration::getBoolIfExists("profiling");
+	if (Configuration::exists("profiling_interval")) {
+		reportInterval = Configuration::get("profiling_interval");
+	}
+	if (enabled && Configuration::exists("scheduling_timings")) {
+		schedulingTimings = std::ofstream(Configuration::get("scheduling_timings"));
+		schedulingTimings << "Time,Invocation type,Request size,Reply size";
+		for (int i = 0; i < NUM_SCHEDULING_STAGES; ++i) {
+			schedulingTimings << "," << asString((SchedulingStage) i);
+		}
+		schedulingTimings << std::endl;
+	}
+}
+
+bool Profiler::isEnabled() {
+	return enabled;
+}
+
+std::chrono::steady_clock::time_point Profiler::now() {
+	return enabled ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+}
+
+double Profiler::elapsed(std::chrono::steady_clock::time_point start) {
+	if (enabled) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+	return 0;
+}
+
+void Profiler::record(ProfilingCategory category, std::chrono::steady_clock::time_point start) {
+	if (enabled) {
+		durations[category] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count();
+	}
+}
+
+void Profiler::addToStage(StageStatistics& statistics, double duration) {
+	statistics.total += duration;
+	statistics.max = std::max(statistics.max, duration);
+	int bucket = 0;
+	for (double bound = 1e-6; duration >= bound && bucket < NUM_HISTOGRAM_BUCKETS - 1; bound *= 2) {
+		++bucket;
+	}
+	++statistics.histogram[bucket];
+}
+
+void Profiler::recordScheduling(const SchedulingTiming& timing) {
+	if (!enabled) {
+		return;
+	}
+	const auto& stages = timing.durations;
+	SchedulingStatistics& statistics = schedulingStatistics[timing.invocationType];
+	++statistics.count;
+	statistics.requestBytes += timing.requestSize;
+	statistics.replyBytes += timing.replySize;
+	double total = 0;
+	for (int i = 0; i < NUM_SCHEDULING_STAGES; ++i) {
+		addToStage(statistics.stages[i], stages[i]);
+		total += stages[i];
+	}
+	addToStage(statistics.stages[NUM_SCHEDULING_STAGES], total);
+
+	auto toNanoseconds = [](double seconds) { return (long long) (seconds * 1e9); };
+	durations[PROFILE_SERIALIZATION] += toNanoseconds(stages[STAGE_BUILD] + stages[STAGE_DUMP] + stages[STAGE_PARSE]);
+	durations[PROFILE_SCHEDULING] += toNanoseconds(stages[STAGE_SEND] + stages[STAGE_WAIT]);
+	++counters[COUNT_SCHEDULING_INVOCATIONS];
+
+	if (schedulingTimings.is_open()) {
+		schedulingTimings << simgrid::s4u::Engine::get_clock() << "," << asString(timing.invocationType) << ","
+						  << timing.requestSize << "," << timing.replySize;
+		for (double duration: stages) {
+			schedulingTimings << "," << duration;
+		}
+		schedulingTimings << std::endl;
+	}
+}
+
+double Profiler::estimatePercentile(const StageStatistics& statistics, long long count, double percentile) {
+	long long threshold = (long long) std::ceil(percentile * (double) count);
+	long long cumulative = 0;
+	for (int i = 0; i < NUM_HISTOGRAM_BUCKETS; ++i) {
+		cumulative += statistics.histogram[i];
+		if (cumulative >= threshold) {
+			// upper bound of the bucket, never beyond the observed maximum
+			return std::min(1e-6 * std::pow(2, i), statistics.max);
+		}
+	}
+	return statistics.max;
+}
+
+nlohmann::json Profiler::schedulingToJson() {
+	nlohmann::json json = nlohmann::json::object();
+	for (const auto& [invocationType, statistics]: schedulingStatistics) {
+		nlohmann::json& jsonType = json[asString(invocationType)];
+		jsonType["count"] = statistics.count;
+		jsonType["mean_request_size"] = (double) statistics.requestBytes / (double) statistics.count;
+		jsonType["mean_reply_size"] = (double) statistics.replyBytes / (double) statistics.count;
+		for (int i = 0; i <= NUM_SCHEDULING_STAGES; ++i) {
+			const StageStatistics& stage = statistics.stages[i];
+			nlohmann::json& jsonStage = jsonType["stages"][asString((SchedulingStage) i)];
+			jsonStage["total"] = stage.total;
+			jsonStage["mean"] = stage.total / (double) statistics.count;
+			jsonStage["p50"] = estimatePercentile(stage, statistics.count, 0.5);
+			jsonStage["p90"] = estimatePercentile(stage, statistics.count, 0.9);
+			jsonStage["p99"] = estimatePercentile(stage, statistics.count, 0.99);
+			jsonStage["max"] = stage.max;
+			int lastBucket = NUM_HISTOGRAM_BUCKETS - 1;
+			while (lastBucket > 0 && stage.histogram[lastBucket] == 0) {
+				--lastBucket;
+			}
+			jsonStage["histogram_us"] = std::vector<long long>(stage.histogram.begin(),
+															   stage.histogram.begin() + lastBucket + 1);
+		}
+	}
+	return json;
+}
+
+void Profiler::count(ProfilingCounter counter) {
+	if (enabled) {
+		++counters[counter];
+		if (counter == COUNT_EVENTS) {
+			updateThroughput();
+		}
+	}
+}
+
+void Profiler::countActivities(ActivityCategory category, JobType jobType, long long number) {
+	if (enabled) {
+		activities[category][jobType] += number;
+	}
+}
+
+void Profiler::updateThroughput() {
+	auto now = std::chrono::steady_clock::now();
+	double clock = simgrid::s4u::Engine::get_clock();
+	long long events = counters[COUNT_EVENTS];
+	if (!throughputStarted) {
+		throughputStarted = true;
+		lastReport = now;
+		lastReportClock = clock;
+		lastReportEvents = events;
+		return;
+	}
+	double wallTime = std::chrono::duration<double>(now - lastReport).count();
+	if (wallTime < reportInterval) {
+		return;
+	}
+	std::stringstream stream;
+	stream << std::fixed << std::setprecision(1) << (clock - lastReportClock) / wallTime << " simulated s/s, "
+		   << std::setprecision(0) << (double) (events - lastReportEvents) / wallTime << " events/s";
+	throughput = stream.str();
+	XBT_INFO("Throughput at simulated time %f: %s", clock, throughput.c_str());
+	lastReport = now;
+	lastReportClock = clock;
+	lastReportEvents = events;
+}
+
+const std::string& Profiler::getThroughput() {
+	return throughput;
+}
+
+double Profiler::getDuration(ProfilingCategory category) {
+	return durations[category] / 1e9;
+}
+
+long long Profiler::getCount(ProfilingCounter counter) {
+	return counters[counter];
+}
+
+long Profiler::getPeakMemoryUsage() {
+	struct rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+nlohmann::json Profiler::toJson() {
+	nlohmann::json json;
+	for (int i = 0; i < NUM_PROFILING_CATEGORIES; ++i) {
+		json["durations"][asString((ProfilingCategory) i)] = getDuration((ProfilingCategory) i);
+	}
+	for (int i = 0; i < NUM_PROFILING_COUNTERS; ++i) {
+		json["counters"][asString((ProfilingCounter) i)] = getCount((ProfilingCounter) i);
+	}
+	for (int i = 0; i < NUM_ACTIVITY_CATEGORIES; ++i) {
+		nlohmann::json& jsonCategory = json["activities"][asString((ActivityCategory) i)];
+		long long total = 0;
+		for (int jobType = RIGID; jobType <= ADAPTIVE; ++jobType) {
+			jsonCategory[asString((JobType) jobType)] = activities[i][jobType];
+			total += activities[i][jobType];
+		}
+		jsonCategory["total"] = total;
+	}
+	json["scheduling"] = schedulingToJson();
+	json["simulated_time"] = simgrid::s4u::Engine::get_clock();
+	json["peak_memory_usage_kb"] = getPeakMemoryUsage();
+	return json;
+}
+
+void Profiler::writeSummary() {
+	if (schedulingTimings.is_open()) {
+		schedulingTimings.close();
+	}
+	if (!enabled) {
+		return;
+	}
+	if (Configuration::exists("profiling_output")) {
+		std::ofstream summary(Configuration::get("profiling_output"));
+		summary << toJson().dump(4) << std::endl;
+	} else {
+		std::cout << toJson().dump(4) << std::endl;
+	}
+}
@@ -0,0 +1,156 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_PROFILER_H
+#define ELASTISIM_PROFILER_H
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <fstream>
+#include <json.hpp>
+#include "Scheduler.h"
+
+enum ProfilingCategory {
+	PROFILE_PLATFORM,
+	PROFILE_PARSING,
+	PROFILE_MODEL_EVALUATION,
+	PROFILE_SERIALIZATION,
+	PROFILE_SCHEDULING,
+	PROFILE_SIMULATION,
+	NUM_PROFILING_CATEGORIES
+};
+
+enum ProfilingCounter {
+	COUNT_EVENTS,
+	COUNT_SCHEDULING_INVOCATIONS,
+	COUNT_MODEL_EVALUATIONS,
+	COUNT_APPLICATION_ACTORS,
+	COUNT_GPU_ACTORS,
+	COUNT_GPU_LINK_ACTORS,
+	COUNT_WALLTIME_MONITOR_ACTORS,
+	COUNT_BARRIER_WAITS,
+	NUM_PROFILING_COUNTERS
+};
+
+enum ActivityCategory {
+	ACTIVITY_EXEC,
+	ACTIVITY_PTASK,
+	ACTIVITY_COMM,
+	ACTIVITY_IO,
+	NUM_ACTIVITY_CATEGORIES
+};
+
+enum SchedulingStage {
+	STAGE_BUILD,
+	STAGE_DUMP,
+	STAGE_SEND,
+	STAGE_WAIT,
+	STAGE_PARSE,
+	STAGE_APPLY,
+	NUM_SCHEDULING_STAGES
+};
+
+// wall-clock breakdown of a single round trip to the scheduling algorithm
+struct SchedulingTiming {
+	InvocationType invocationType;
+	std::array<double, NUM_SCHEDULING_STAGES> durations{};
+	size_t requestSize = 0;
+	size_t replySize = 0;
+};
+
+class Profiler {
+
+private:
+	// bucket i counts durations below 2^i microseconds that did not fit into bucket i - 1
+	static const int NUM_HISTOGRAM_BUCKETS = 40;
+
+	struct StageStatistics {
+		double total = 0;
+		double max = 0;
+		std::array<long long, NUM_HISTOGRAM_BUCKETS> histogram{};
+	};
+
+	struct SchedulingStatistics {
+		long long count = 0;
+		size_t requestBytes = 0;
+		size_t replyBytes = 0;
+		std::array<StageStatistics, NUM_SCHEDULING_STAGES + 1> stages;
+	};
+
+	static bool enabled;
+	static std::array<std::atomic<long long>, NUM_PROFILING_CATEGORIES> durations;
+	static std::array<std::atomic<long long>, NUM_PROFILING_COUNTERS> counters;
+	static std::map<InvocationType, SchedulingStatistics> schedulingStatistics;
+	static std::ofstream schedulingTimings;
+	static std::array<std::array<long long, ADAPTIVE + 1>, NUM_ACTIVITY_CATEGORIES> activities;
+	static double reportInterval;
+	static bool throughputStarted;
+	static std::chrono::steady_clock::time_point lastReport;
+	static double lastReportClock;
+	static long long lastReportEvents;
+	static std::string throughput;
+
+	[[nodiscard]] static std::string asString(ProfilingCategory category);
+
+	[[nodiscard]] static std::string asString(ProfilingCounter counter);
+
+	[[nodiscard]] static std::string asString(SchedulingStage stage);
+
+	[[nodiscard]] static std::string asString(InvocationType invocationType);
+
+	[[nodiscard]] static std::string asString(ActivityCategory category);
+
+	[[nodiscard]] static std::string asString(JobType jobType);
+
+	static void updateThroughput();
+
+	static void addToStage(StageStatistics& statistics, double duration);
+
+	[[nodiscard]] static double estimatePercentile(const StageStatistics& statistics, long long count,
+												   double percentile);
+
+	[[nodiscard]] static nlohmann::json schedulingToJson();
+
+public:
+	static void init();
+
+	[[nodiscard]] static bool isEnabled();
+
+	[[nodiscard]] static std::chrono::steady_clock::time_point now();
+
+	[[nodiscard]] static double elapsed(std::chrono::steady_clock::time_point start);
+
+	static void record(ProfilingCategory category, std::chrono::steady_clock::time_point start);
+
+	static void recordScheduling(const SchedulingTiming& timing);
+
+	static void count(ProfilingCounter counter);
+
+	static void countActivities(ActivityCategory category, JobType jobType, long long number = 1);
+
+	[[nodiscard]] static const std::string& getThroughput();
+
+	[[nodiscard]] static double getDuration(ProfilingCategory category);
+
+	[[nodiscard]] static long long getCount(ProfilingCounter counter);
+
+	[[nodiscard]] static long getPeakMemoryUsage();
+
+	[[nodiscard]] static nlohmann::json toJson();
+
+	static void writeSummary();
+
+};
+
+
+#endif //ELASTISIM_PROFILER_H
@@ -12,11 +12,14 @@
 
 #include <simgrid/s4u.hpp>
 #include <regex>
+#include <thread>
+#include <atomic>
 
 #include <exprtk.hpp>
 
 #include "Phase.h"
 #include "Workload.h"
+#include "Node.h"
 #include "BusyWaitTask.h"
 #include "PfsReadTask.h"
 #include "BurstBufferReadTask.h"
@@ -26,6 +29,9 @@
 #include "IdleTask.h"
 #include "CombinedCpuTask.h"
 #include "CombinedGpuTask.h"
+#include "WaitTask.h"
+#include "Configuration.h"
+#include "Profiler.h"
 
 #define EUCLIDIAN_MOD(a, b)  ((a) < 0 ? ((((a) % (b)) + (b)) % (b)) : ((a) % (b)))
 
@@ -162,6 +168,13 @@ std::map<std::string, std::string> Utility::readStringMap(nlohmann::json jsonMap
 	return map;
 }
 
+const nlohmann::json& Utility::getOrNull(const nlohmann::json& json, const std::string& key) {
+	// missing keys read as null without copying or inserting into the shared application model
+	static const nlohmann::json null;
+	auto it = json.find(key);
+	return it != json.end() ? *it : null;
+}
+
 std::unique_ptr<Task>
 Utility::readTask(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments, int numNodes,
 				  int numGpusPerNode) {
@@ -191,21 +204,24 @@ Utility::readTask(nlohmann::json jsonTask, const std::map<std::string, std::stri
 											 numGpusPerNode);
 	} else if (toLower(jsonTask["type"]) == "idle") {
 		task = createDelayTask<IdleTask>(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode);
-	} else if (toLower(jsonTask["type"]) == "cpu") {
+	} else if (toLower(jsonTask["type"]) == "cpu" || isCollective(toLower(jsonTask["type"]))) {
 		task = createCombinedCpuTask(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode);
-	} else if (toLower(jsonTask["type"]) == "gpu") {
+	} else if (toLower(jsonTask["type"]) == "gpu" || isGpuCollective(toLower(jsonTask["type"]))) {
 		task = createCombinedGpuTask(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode);
 	} else if (toLower(jsonTask["type"]) == "pfs_read") {
-		task = createIoTask<PfsReadTask>(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode);
+		task = createIoTask<PfsReadTask>(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode,
+										 readPfsStriping(jsonTask, arguments));
 	} else if (toLower(jsonTask["type"]) == "pfs_write") {
 		task = createIoTask<PfsWriteTask>(jsonTask, name, iterations, synchronized, arguments, numNodes,
-										  numGpusPerNode);
+										  numGpusPerNode, readPfsStriping(jsonTask, arguments));
 	} else if (toLower(jsonTask["type"]) == "bb_read") {
 		task = createIoTask<BurstBufferReadTask>(jsonTask, name, iterations, synchronized, arguments, numNodes,
 												 numGpusPerNode);
 	} else if (toLower(jsonTask["type"]) == "bb_write") {
 		task = createIoTask<BurstBufferWriteTask>(jsonTask, name, iterations, synchronized, arguments, numNodes,
 												  numGpusPerNode);
+	} else if (toLower(jsonTask["type"]) == "wait") {
+		task = std::make_unique<WaitTask>(name, iterations, synchronized);
 	} else if (toLower(jsonTask["type"]) == "sequence") {
 		task = createSequenceTask(jsonTask, name, iterations, synchronized, arguments, numNodes, numGpusPerNode);
 	} else {
@@ -218,70 +234,141 @@ Utility::readTask(nlohmann::json jsonTask, const std::map<std::string, std::stri
 	return task;
 }
 
+std::vector<std::vector<size_t>> Utility::readDependencies(const nlohmann::json& jsonTasks) {
+	std::vector<std::vector<size_t>> dependencies;
+	std::map<std::string, size_t> indices;
+	bool hasDependencies = false;
+	for (auto& jsonTask: jsonTasks) {
+		std::vector<std::string> names;
+		const nlohmann::json& dependsOn = getOrNull(jsonTask, "depends_on");
+		if (dependsOn.is_string()) {
+			names.push_back(dependsOn);
+		} else if (dependsOn.is_array()) {
+			std::vector<std::string> local = dependsOn;
+			names = std::move(local);
+		}
+		// referring only to earlier tasks keeps the listed order a valid execution order
+		std::vector<size_t> taskDependencies;
+		for (const auto& name: names) {
+			auto it = indices.find(name);
+			if (it == std::end(indices)) {
+				xbt_die("Dependency %s does not name a task listed before in the phase", name.c_str());
+			}
+			taskDependencies.push_back(it->second);
+		}
+		hasDependencies = hasDependencies || !taskDependencies.empty();
+		const nlohmann::json& name = getOrNull(jsonTask, "name");
+		if (name.is_string()) {
+			indices[name] = dependencies.size();
+		}
+		dependencies.push_back(std::move(taskDependencies));
+	}
+	if (!hasDependencies) {
+		dependencies.clear();
+	}
+	return dependencies;
+}
+
 std::unique_ptr<Phase>
-Utility::readPhase(nlohmann::json jsonPhase, const std::map<std::string, std::string>& arguments, int numNodes,
-				   int numGpusPerNode) {
+Utility::readPhase(const nlohmann::json& jsonPhase, const std::map<std::string, std::string>& arguments,
+				   int numNodes, int numGpusPerNode) {
 	int iterations = 1;
-	if (jsonPhase["iterations"].is_number_unsigned()) {
-		iterations = jsonPhase["iterations"];
-	} else if (jsonPhase["iterations"].is_string()) {
-		iterations = (int) evaluateFormula(applyArguments(jsonPhase["iterations"], arguments));
+	const nlohmann::json& jsonIterations = getOrNull(jsonPhase, "iterations");
+	if (jsonIterations.is_number_unsigned()) {
+		iterations = jsonIterations;
+	} else if (jsonIterations.is_string()) {
+		iterations = (int) evaluateFormula(applyArguments(jsonIterations, arguments));
 	}
 	bool schedulingPoint = true;
-	if (jsonPhase["scheduling_point"].is_boolean()) {
+	if (getOrNull(jsonPhase, "scheduling_point").is_boolean()) {
 		schedulingPoint = jsonPhase["scheduling_point"];
 	}
 	std::string evolvingRequest;
-	if (jsonPhase["evolving_request"].is_string()) {
+	if (getOrNull(jsonPhase, "evolving_request").is_string()) {
 		evolvingRequest = jsonPhase["evolving_request"];
 	}
 	bool barrier = true;
-	if (jsonPhase["barrier"].is_boolean()) {
+	if (getOrNull(jsonPhase, "barrier").is_boolean()) {
 		barrier = jsonPhase["barrier"];
 	}
+	const nlohmann::json& jsonTasks = getOrNull(jsonPhase, "tasks");
 	std::deque<std::unique_ptr<Task>> tasks;
-	for (auto& task: jsonPhase["tasks"]) {
+	for (auto& task: jsonTasks) {
 		tasks.push_back(readTask(task, arguments, numNodes, numGpusPerNode));
 	}
-	return std::make_unique<Phase>(std::move(tasks), iterations, schedulingPoint, evolvingRequest, barrier);
+	return std::make_unique<Phase>(std::move(tasks), iterations, schedulingPoint, evolvingRequest, barrier,
+								   readDependencies(jsonTasks));
 }
 
 std::unique_ptr<Phase>
-Utility::readOneTimePhase(nlohmann::json jsonPhase, const std::map<std::string, std::string>& arguments, int numNodes,
-						  int numGpusPerNode) {
+Utility::readOneTimePhase(const nlohmann::json& jsonPhase, const std::map<std::string, std::string>& arguments,
+						  int numNodes, int numGpusPerNode) {
 
 	if (jsonPhase.is_null()) {
 		return nullptr;
 	}
 	int iterations = 1;
-	if (jsonPhase["iterations"].is_number_unsigned()) {
+	if (getOrNull(jsonPhase, "iterations").is_number_unsigned()) {
 		iterations = jsonPhase["iterations"];
 	}
 	bool schedulingPoint = false;
 	std::string evolvingRequest;
 	bool barrier = false;
+	const nlohmann::json& jsonTasks = getOrNull(jsonPhase, "tasks");
 	std::deque<std::unique_ptr<Task>> tasks;
-	for (auto& task: jsonPhase["tasks"]) {
+	for (auto& task: jsonTasks) {
 		tasks.push_back(readTask(task, arguments, numNodes, numGpusPerNode));
 	}
-	return std::make_unique<Phase>(std::move(tasks), iterations, schedulingPoint, evolvingRequest, barrier);
+	return std::make_unique<Phase>(std::move(tasks), iterations, schedulingPoint, evolvingRequest, barrier,
+								   readDependencies(jsonTasks));
 }
 
 std::unique_ptr<Workload>
-Utility::readWorkload(const std::string& workloadFile, const std::map<std::string, std::string>& arguments,
+Utility::readWorkload(const nlohmann::json& json, const std::map<std::string, std::string>& arguments,
 					  int numNodes, int numGpusPerNode) {
-	std::ifstream stream(workloadFile);
-	nlohmann::json json = nlohmann::json::parse(stream);
-	std::unique_ptr<Phase> onInitialize = readOneTimePhase(json["on_init"], arguments, numNodes, numGpusPerNode);
-	std::unique_ptr<Phase> onReconfiguration = readOneTimePhase(json["on_reconfiguration"], arguments, numNodes,
-																numGpusPerNode);
-	std::unique_ptr<Phase> onExpansion = readOneTimePhase(json["on_expansion"], arguments, numNodes, numGpusPerNode);
+	std::unique_ptr<Phase> onInitialize = readOneTimePhase(getOrNull(json, "on_init"), arguments, numNodes,
+														   numGpusPerNode);
+	std::unique_ptr<Phase> onReconfiguration = readOneTimePhase(getOrNull(json, "on_reconfiguration"), arguments,
+																numNodes, numGpusPerNode);
+	std::unique_ptr<Phase> onExpansion = readOneTimePhase(getOrNull(json, "on_expansion"), arguments, numNodes,
+														  numGpusPerNode);
 	std::deque<std::unique_ptr<Phase>> phases;
-	for (auto& phase: json["phases"]) {
+	for (auto& phase: getOrNull(json, "phases")) {
 		phases.push_back(readPhase(phase, arguments, numNodes, numGpusPerNode));
 	}
+	std::string stateModel;
+	const nlohmann::json& stateBytes = getOrNull(json, "state_bytes");
+	if (stateBytes.is_number()) {
+		stateModel = std::to_string((double) stateBytes);
+	} else if (stateBytes.is_string()) {
+		stateModel = applyArguments(stateBytes, arguments);
+	}
 	return std::make_unique<Workload>(std::move(onInitialize), std::move(onReconfiguration), std::move(onExpansion),
-									  std::move(phases));
+									  std::move(phases), stateModel);
+}
+
+template<typename F>
+void Utility::parallelFor(size_t size, F function) {
+	size_t numThreads = std::thread::hardware_concurrency();
+	if (Configuration::exists("loader_threads")) {
+		numThreads = Configuration::get("loader_threads");
+	}
+	numThreads = std::max(std::min(numThreads, size), (size_t) 1);
+	std::atomic<size_t> next(0);
+	const auto& worker = [&next, &function, size]() {
+		for (size_t i = next++; i < size; i = next++) {
+			function(i);
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+	for (size_t i = 1; i < numThreads; ++i) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread: threads) {
+		thread.join();
+	}
 }
 
 template<typename T>
@@ -330,11 +417,113 @@ Utility::createDelayTask(nlohmann::json jsonTask, const std::string& name, const
 	}
 }
 
-template<typename T>
+PfsStriping Utility::readPfsStriping(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments) {
+	PfsStriping striping;
+	if (jsonTask["stripe_count"].is_number_unsigned()) {
+		striping.stripeCount = jsonTask["stripe_count"];
+	} else if (jsonTask["stripe_count"].is_string()) {
+		striping.stripeCount = (int) evaluateFormula(applyArguments(jsonTask["stripe_count"], arguments));
+	}
+	if (jsonTask["stripe_size"].is_number()) {
+		striping.stripeSize = jsonTask["stripe_size"];
+	} else if (jsonTask["stripe_size"].is_string()) {
+		striping.stripeSize = evaluateFormula(applyArguments(jsonTask["stripe_size"], arguments));
+	}
+	if (jsonTask["stripe_selection"].is_string()) {
+		std::string selection = toLower(jsonTask["stripe_selection"]);
+		if (selection == "round_robin") {
+			striping.selection = ROUND_ROBIN;
+		} else if (selection == "job_hash") {
+			striping.selection = JOB_HASH;
+		} else {
+			xbt_die("Invalid stripe selection %s", selection.c_str());
+		}
+	}
+	if (jsonTask["file"].is_string()) {
+		striping.file = jsonTask["file"];
+	}
+	return striping;
+}
+
+bool Utility::isCollective(const std::string& type) {
+	return type == "allreduce" || type == "bcast" || type == "allgather" || type == "reduce_scatter" ||
+		   type == "alltoall";
+}
+
+bool Utility::isGpuCollective(const std::string& type) {
+	return type.rfind("gpu_", 0) == 0 && isCollective(type.substr(4));
+}
+
+std::string Utility::readCollectiveModel(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments) {
+	if (jsonTask["bytes"].is_number()) {
+		return std::to_string((double) jsonTask["bytes"]);
+	} else if (jsonTask["bytes"].is_string()) {
+		return applyArguments(jsonTask["bytes"], arguments);
+	} else {
+		xbt_die("Collectives require the buffer size as number or string type");
+	}
+}
+
+Collective Utility::readCollective(nlohmann::json jsonTask, const std::string& type, double bytes) {
+	CollectiveOperation operation;
+	if (type == "allreduce") {
+		operation = COLLECTIVE_ALLREDUCE;
+	} else if (type == "bcast") {
+		operation = COLLECTIVE_BCAST;
+	} else if (type == "allgather") {
+		operation = COLLECTIVE_ALLGATHER;
+	} else if (type == "reduce_scatter") {
+		operation = COLLECTIVE_REDUCE_SCATTER;
+	} else if (type == "alltoall") {
+		operation = COLLECTIVE_ALLTOALL;
+	} else {
+		xbt_die("Invalid collective %s", type.c_str());
+	}
+	std::string algorithmName = operation == COLLECTIVE_BCAST ? "binomial_tree" : "ring";
+	if (jsonTask["algorithm"].is_string()) {
+		algorithmName = toLower(jsonTask["algorithm"]);
+	}
+	CollectiveAlgorithm algorithm;
+	if (algorithmName == "ring") {
+		algorithm = ALGORITHM_RING;
+	} else if (algorithmName == "recursive_doubling") {
+		algorithm = ALGORITHM_RECURSIVE_DOUBLING;
+	} else if (algorithmName == "binomial_tree") {
+		algorithm = ALGORITHM_BINOMIAL_TREE;
+	} else if (algorithmName == "rabenseifner") {
+		algorithm = ALGORITHM_RABENSEIFNER;
+	} else {
+		xbt_die("Invalid collective algorithm %s", algorithmName.c_str());
+	}
+	if (!Collective::isAvailable(operation, algorithm)) {
+		xbt_die("Collective algorithm %s is not available for %s", algorithmName.c_str(), type.c_str());
+	}
+	CollectiveAlgorithm intraNodeAlgorithm = ALGORITHM_RING;
+	if (jsonTask["intra_node_algorithm"].is_string()) {
+		std::string intraNodeAlgorithmName = toLower(jsonTask["intra_node_algorithm"]);
+		if (intraNodeAlgorithmName == "binomial_tree") {
+			intraNodeAlgorithm = ALGORITHM_BINOMIAL_TREE;
+		} else if (intraNodeAlgorithmName != "ring") {
+			xbt_die("Invalid intra-node collective algorithm %s", intraNodeAlgorithmName.c_str());
+		}
+	}
+	bool analytic = false;
+	if (jsonTask["collective_model"].is_string()) {
+		std::string model = toLower(jsonTask["collective_model"]);
+		if (model == "analytic") {
+			analytic = true;
+		} else if (model != "steps") {
+			xbt_die("Invalid collective model %s", model.c_str());
+		}
+	}
+	return {operation, algorithm, analytic, bytes, intraNodeAlgorithm};
+}
+
+template<typename T, typename... Args>
 std::unique_ptr<T>
 Utility::createIoTask(nlohmann::json jsonTask, const std::string& name, const std::string& iterations,
 					  bool synchronized, const std::map<std::string, std::string>& arguments, int numNodes,
-					  int numGpusPerNode) {
+					  int numGpusPerNode, Args&& ... extraArguments) {
 
 	bool async = false;
 	if (jsonTask["async"].is_boolean()) {
@@ -351,10 +540,12 @@ Utility::createIoTask(nlohmann::json jsonTask, const std::string& name, const st
 		} else {
 			if (jsonTask["bytes"].is_number()) {
 				ioModel = std::to_string((double) jsonTask["bytes"]);
-				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern);
+				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern,
+										   std::forward<Args>(extraArguments)...);
 			} else if (jsonTask["bytes"].is_string()) {
 				ioModel = applyArguments(jsonTask["bytes"], arguments);
-				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern);
+				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern,
+										   std::forward<Args>(extraArguments)...);
 			} else {
 				xbt_die("%s pattern requires a number or string type", asString(pattern).c_str());
 			}
@@ -365,14 +556,17 @@ Utility::createIoTask(nlohmann::json jsonTask, const std::string& name, const st
 				xbt_die("VECTOR pattern requires an array type");
 			}
 			ioSizes = jsonTask["bytes"];
-			return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern);
+			return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern,
+									   std::forward<Args>(extraArguments)...);
 		} else {
 			if (jsonTask["bytes"].is_number()) {
 				ioSizes = createVector((double) jsonTask["bytes"], pattern, numNodes);
-				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern);
+				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern,
+										   std::forward<Args>(extraArguments)...);
 			} else if (jsonTask["bytes"].is_string()) {
 				ioSizes = createVector(applyArguments(jsonTask["bytes"], arguments), pattern, numNodes, numGpusPerNode);
-				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern);
+				return std::make_unique<T>(name, iterations, synchronized, async, ioSizes, ioModel, pattern,
+										   std::forward<Args>(extraArguments)...);
 			} else {
 				xbt_die("%s pattern requires a number or string type", asString(pattern).c_str());
 			}
@@ -430,9 +624,20 @@ Utility::createCombinedGpuTask(nlohmann::json jsonTask, const std::string& name,
 	std::optional<std::vector<double>> intraNodeCommunication;
 	std::optional<std::vector<double>> interNodeCommunication;
 	std::optional<std::string> comModel;
+	std::optional<Collective> collective;
 
 	MatrixPattern comPattern;
-	if (!jsonTask["bytes"].is_null()) {
+	std::string type = toLower(jsonTask["type"]);
+	if (isGpuCollective(type)) {
+		std::string model = readCollectiveModel(jsonTask, arguments);
+		if (numNodes == 0) {
+			comModel = model;
+			collective.emplace(readCollective(jsonTask, type.substr(4), 0));
+		} else {
+			collective.emplace(readCollective(jsonTask, type.substr(4),
+											  evaluateFormula(model, numNodes, numGpusPerNode)));
+		}
+	} else if (!jsonTask["bytes"].is_null()) {
 		comPattern = asMatrixPattern(jsonTask["communication_pattern"]);
 		if (numNodes == 0) {
 			if (jsonTask["bytes"].is_number()) {
@@ -461,8 +666,14 @@ Utility::createCombinedGpuTask(nlohmann::json jsonTask, const std::string& name,
 
 	}
 
-	return std::make_unique<CombinedGpuTask>(name, iterations, synchronized, flops, gpuModel, gpuPattern, comModel,
-											 comPattern, intraNodeCommunication, interNodeCommunication);
+	bool async = false;
+	if (jsonTask["async"].is_boolean()) {
+		async = jsonTask["async"];
+	}
+
+	return std::make_unique<CombinedGpuTask>(name, iterations, synchronized, async, flops, gpuModel, gpuPattern,
+											 comModel, comPattern, intraNodeCommunication, interNodeCommunication,
+											 std::move(collective));
 
 }
 
@@ -515,9 +726,19 @@ Utility::createCombinedCpuTask(nlohmann::json jsonTask, const std::string& name,
 
 	std::optional<std::vector<double>> bytes;
 	std::optional<std::string> comModel;
+	std::optional<Collective> collective;
 
 	MatrixPattern comPattern;
-	if (!jsonTask["bytes"].is_null()) {
+	std::string type = toLower(jsonTask["type"]);
+	if (isCollective(type)) {
+		std::string model = readCollectiveModel(jsonTask, arguments);
+		if (numNodes == 0) {
+			comModel = model;
+			collective.emplace(readCollective(jsonTask, type, 0));
+		} else {
+			collective.emplace(readCollective(jsonTask, type, evaluateFormula(model, numNodes, numGpusPerNode)));
+		}
+	} else if (!jsonTask["bytes"].is_null()) {
 		comPattern = asMatrixPattern(jsonTask["communication_pattern"]);
 		if (numNodes == 0) {
 			if (jsonTask["bytes"].is_number()) {
@@ -553,8 +774,13 @@ Utility::createCombinedCpuTask(nlohmann::json jsonTask, const std::string& name,
 		coupled = jsonTask["coupled"];
 	}
 
-	return std::make_unique<CombinedCpuTask>(name, iterations, synchronized, flops, cpuModel, cpuPattern, comModel,
-											 comPattern, bytes, coupled);
+	bool async = false;
+	if (jsonTask["async"].is_boolean()) {
+		async = jsonTask["async"];
+	}
+
+	return std::make_unique<CombinedCpuTask>(name, iterations, synchronized, async, flops, cpuModel, cpuPattern,
+											 comModel, comPattern, bytes, coupled, std::move(collective));
 
 }
 
@@ -570,16 +796,21 @@ Utility::createSequenceTask(nlohmann::json jsonTask, const std::string& name, co
 }
 
 double Utility::evaluateFormula(const std::string& model) {
+	auto start = Profiler::now();
 	exprtk::parser<double> parser;
 	exprtk::expression<double> expression;
 	if (parser.compile(model, expression)) {
-		return expression.value();
+		double value = expression.value();
+		Profiler::record(PROFILE_MODEL_EVALUATION, start);
+		Profiler::count(COUNT_MODEL_EVALUATIONS);
+		return value;
 	} else {
 		xbt_die("Performance model %s not valid", model.c_str());
 	}
 }
 
 double Utility::evaluateFormula(const std::string& model, int numNodes, int numGpusPerNode) {
+	auto start = Profiler::now();
 	exprtk::parser<double> parser;
 	exprtk::expression<double> expression;
 	std::string substitutedModel = std::regex_replace(model, std::regex("num_nodes"), std::to_string(numNodes));
@@ -588,7 +819,10 @@ double Utility::evaluateFormula(const std::string& model, int numNodes, int numG
 	substitutedModel = std::regex_replace(substitutedModel, std::regex("num_gpus"),
 										  std::to_string(numNodes * numGpusPerNode));
 	if (parser.compile(substitutedModel, expression)) {
-		return expression.value();
+		double value = expression.value();
+		Profiler::record(PROFILE_MODEL_EVALUATION, start);
+		Profiler::count(COUNT_MODEL_EVALUATIONS);
+		return value;
 	} else {
 		xbt_die("Performance model %s not valid", model.c_str());
 	}
@@ -596,6 +830,7 @@ double Utility::evaluateFormula(const std::string& model, int numNodes, int numG
 
 double Utility::evaluateFormula(const std::string& model, int numNodes, int numGpusPerNode,
 								const std::map<std::string, std::string>& runtimeArguments) {
+	auto start = Profiler::now();
 
 	exprtk::parser<double> parser;
 	exprtk::expression<double> expression;
@@ -610,7 +845,10 @@ double Utility::evaluateFormula(const std::string& model, int numNodes, int numG
 	}
 
 	if (parser.compile(substitutedModel, expression)) {
-		return expression.value();
+		double value = expression.value();
+		Profiler::record(PROFILE_MODEL_EVALUATION, start);
+		Profiler::count(COUNT_MODEL_EVALUATIONS);
+		return value;
 	} else {
 		xbt_die("Performance model %s not valid", model.c_str());
 	}
@@ -619,6 +857,7 @@ double Utility::evaluateFormula(const std::string& model, int numNodes, int numG
 double Utility::evaluateFormula(const std::string& model, int numNodes, int numGpusPerNode,
 								const std::map<std::string, std::string>& runtimeArguments,
 								const std::map<std::string, std::string>& additionalArguments) {
+	auto start = Profiler::now();
 	exprtk::parser<double> parser;
 	exprtk::expression<double> expression;
 	std::string substitutedModel = model;
@@ -638,7 +877,10 @@ double Utility::evaluateFormula(const std::string& model, int numNodes, int numG
 	}
 
 	if (parser.compile(substitutedModel, expression)) {
-		return expression.value();
+		double value = expression.value();
+		Profiler::record(PROFILE_MODEL_EVALUATION, start);
+		Profiler::count(COUNT_MODEL_EVALUATIONS);
+		return value;
 	} else {
 		xbt_die("Performance model %s not valid", model.c_str());
 	}
@@ -804,20 +1046,118 @@ Utility::createMatrices(const std::string& model, MatrixPattern pattern, int num
 	return createMatrices(size, pattern, numNodes, numGpusPerNode);
 }
 
+uint64_t Utility::hash(const std::string& string) {
+	// 64-bit FNV-1a, stable across platforms and standard library implementations
+	uint64_t hash = 0xcbf29ce484222325;
+	for (unsigned char character: string) {
+		hash ^= character;
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+nlohmann::json Utility::compressNodeIds(const std::vector<Node*>& nodes) {
+	// consecutive ascending IDs are merged into inclusive [first, last] ranges, the order of nodes is preserved
+	nlohmann::json json = nlohmann::json::array();
+	size_t i = 0;
+	while (i < nodes.size()) {
+		int first = nodes[i]->getId();
+		int last = first;
+		while (i + 1 < nodes.size() && nodes[i + 1]->getId() == last + 1) {
+			++last;
+			++i;
+		}
+		if (first == last) {
+			json.push_back(first);
+		} else {
+			json.push_back({first, last});
+		}
+		++i;
+	}
+	return json;
+}
+
+std::vector<Node*> Utility::expandNodeIds(const nlohmann::json& jsonNodeIds, const std::vector<Node*>& nodes) {
+	int numNodes = nodes.size();
+	std::vector<Node*> expandedNodes;
+	for (const auto& entry: jsonNodeIds) {
+		if (entry.is_array()) {
+			if (entry.size() != 2) {
+				xbt_die("Node ranges have to be specified as [first, last]");
+			}
+			int first = entry[0];
+			int last = entry[1];
+			if (first < 0 || last >= numNodes || first > last) {
+				xbt_die("Invalid node range [%d, %d]", first, last);
+			}
+			expandedNodes.insert(std::end(expandedNodes), std::begin(nodes) + first, std::begin(nodes) + last + 1);
+		} else {
+			expandedNodes.push_back(nodes[entry]);
+		}
+	}
+	return expandedNodes;
+}
+
 std::vector<std::unique_ptr<Job>> Utility::readJobs(const std::string& jobsFile) {
 	std::ifstream stream(jobsFile);
-	nlohmann::json json = nlohmann::json::parse(stream);
+	const nlohmann::json json = nlohmann::json::parse(stream);
+	const nlohmann::json& jsonJobs = json["jobs"];
+	size_t numJobs = jsonJobs.size();
+
+	// validate specifications and collect distinct application models
+	std::vector<JobType> jobTypes(numJobs);
+	std::vector<int> numGpusPerNodes(numJobs);
+	std::vector<std::map<std::string, std::string>> jobArguments(numJobs);
+	std::map<std::string, nlohmann::json> applicationModels;
+	for (size_t i = 0; i < numJobs; ++i) {
+		const nlohmann::json& job = jsonJobs[i];
+		jobTypes[i] = parseJobType(job["type"]);
+		if (job.contains("num_gpus_per_node") && job["num_gpus_per_node"].is_number_unsigned()) {
+			numGpusPerNodes[i] = job["num_gpus_per_node"];
+		}
+		if (job.contains("arguments") && !job["arguments"].is_null()) {
+			jobArguments[i] = readStringMap(job["arguments"]);
+		}
+		if (jobTypes[i] == RIGID) {
+			if (!job.contains("num_nodes") || job["num_nodes"].is_null()) {
+				xbt_die("Requested number of nodes has to be specified for rigid jobs");
+			}
+			int numNodes = job["num_nodes"];
+			if (numNodes < 1) {
+				xbt_die("Requested number of nodes can not be less than 1 for rigid jobs");
+			}
+		}
+		applicationModels[job["application_model"]] = nullptr;
+	}
+
+	// parse each application model once and instantiate all workloads in parallel
+	std::vector<std::pair<const std::string, nlohmann::json>*> models;
+	for (auto& model: applicationModels) {
+		models.push_back(&model);
+	}
+	parallelFor(models.size(), [&models](size_t i) {
+		std::ifstream modelStream(models[i]->first);
+		models[i]->second = nlohmann::json::parse(modelStream);
+	});
+	std::vector<std::unique_ptr<Workload>> workloads(numJobs);
+	parallelFor(numJobs, [&](size_t i) {
+		const nlohmann::json& job = jsonJobs[i];
+		const nlohmann::json& model = applicationModels.at(job["application_model"]);
+		if (jobTypes[i] == RIGID) {
+			workloads[i] = readWorkload(model, jobArguments[i], job["num_nodes"], numGpusPerNodes[i]);
+		} else {
+			workloads[i] = readWorkload(model, jobArguments[i]);
+		}
+	});
+
 	std::vector<std::unique_ptr<Job>> jobs;
-	for (auto& job: json["jobs"]) {
-		JobType jobType = parseJobType(job["type"]);
+	jobs.reserve(numJobs);
+	for (size_t i = 0; i < numJobs; ++i) {
+		nlohmann::json job = jsonJobs[i];
 		double walltime = 0;
 		if (job["walltime"].is_number_unsigned()) {
 			walltime = job["walltime"];
 		}
-		int numGpusPerNode = 0;
-		if (job["num_gpus_per_node"].is_number_unsigned()) {
-			numGpusPerNode = job["num_gpus_per_node"];
-		}
 		int numNodesMin = 0;
 		if (job["num_nodes_min"].is_number_unsigned()) {
 			numNodesMin = job["num_nodes_min"];
@@ -834,33 +1174,19 @@ std::vector<std::unique_ptr<Job>> Utility::readJobs(const std::string& jobsFile)
 		if (job["num_gpus_per_node_max"].is_number_unsigned()) {
 			numGpusPerNodeMax = job["num_gpus_per_node_max"];
 		}
-		std::map<std::string, std::string> arguments;
-		if (!job["arguments"].is_null()) {
-			arguments = readStringMap(job["arguments"]);
-		}
 		std::map<std::string, std::string> attributes;
 		if (!job["attributes"].is_null()) {
 			attributes = readStringMap(job["attributes"]);
 		}
-		if (jobType == RIGID) {
-			if (job["num_nodes"].is_null()) {
-				xbt_die("Requested number of nodes has to be specified for rigid jobs");
-			}
-			int numNodes = job["num_nodes"];
-			if (numNodes < 1) {
-				xbt_die("Requested number of nodes can not be less than 1 for rigid jobs");
-			}
+		if (jobTypes[i] == RIGID) {
 			jobs.push_back(
-					std::make_unique<Job>(walltime, job["num_nodes"], numGpusPerNode,
-										  job["submit_time"], arguments, attributes,
-										  readWorkload(job["application_model"], arguments, job["num_nodes"],
-													   numGpusPerNode)));
+					std::make_unique<Job>(walltime, job["num_nodes"], numGpusPerNodes[i], job["submit_time"],
+										  std::move(jobArguments[i]), attributes, std::move(workloads[i])));
 		} else {
 			jobs.push_back(
-					std::make_unique<Job>(walltime, jobType, numNodesMin, numNodesMax,
-										  numGpusPerNodeMin, numGpusPerNodeMax, job["submit_time"], arguments,
-										  attributes,
-										  readWorkload(job["application_model"], arguments)));
+					std::make_unique<Job>(walltime, jobTypes[i], numNodesMin, numNodesMax, numGpusPerNodeMin,
+										  numGpusPerNodeMax, job["submit_time"], std::move(jobArguments[i]),
+										  attributes, std::move(workloads[i])));
 		}
 	}
 	return jobs;
@@ -11,11 +11,14 @@
 #ifndef ELASTISIM_UTILITY_H
 #define ELASTISIM_UTILITY_H
 
+#include <cstdint>
 #include <deque>
 #include <json.hpp>
 #include "Task.h"
 #include "CombinedTask.h"
 #include "IoTask.h"
+#include "PfsTask.h"
+#include "Collective.h"
 #include "Job.h"
 
 
@@ -27,6 +30,8 @@ class Workload;
 
 class Job;
 
+class Node;
+
 class Utility {
 
 private:
@@ -45,33 +50,53 @@ private:
 	[[nodiscard]] static std::string
 	applyArguments(const std::string& model, const std::map<std::string, std::string>& arguments);
 
+	[[nodiscard]] static const nlohmann::json& getOrNull(const nlohmann::json& json, const std::string& key);
+
 	[[nodiscard]] static std::map<std::string, std::string> readStringMap(nlohmann::json jsonMap);
 
 	[[nodiscard]] static std::unique_ptr<Task>
 	readTask(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments, int numNodes,
 			 int numGpusPerNode);
 
+	[[nodiscard]] static std::vector<std::vector<size_t>> readDependencies(const nlohmann::json& jsonTasks);
+
 	[[nodiscard]] static std::unique_ptr<Phase>
-	readPhase(nlohmann::json jsonPhase, const std::map<std::string, std::string>& arguments, int numNodes,
+	readPhase(const nlohmann::json& jsonPhase, const std::map<std::string, std::string>& arguments, int numNodes,
 			  int numGpusPerNode);
 
 	[[nodiscard]] static std::unique_ptr<Phase>
-	readOneTimePhase(nlohmann::json jsonPhase, const std::map<std::string, std::string>& arguments, int numNodes,
-					 int numGpusPerNode);
+	readOneTimePhase(const nlohmann::json& jsonPhase, const std::map<std::string, std::string>& arguments,
+					 int numNodes, int numGpusPerNode);
 
 	[[nodiscard]] static std::unique_ptr<Workload>
-	readWorkload(const std::string& workloadFile, const std::map<std::string, std::string>& arguments,
-				 int numNodes = 0, int numGpusPerNode = 0);
+	readWorkload(const nlohmann::json& json, const std::map<std::string, std::string>& arguments, int numNodes = 0,
+				 int numGpusPerNode = 0);
+
+	template<typename F>
+	static void parallelFor(size_t size, F function);
 
 	template<typename T>
 	[[nodiscard]] static std::unique_ptr<T>
 	createDelayTask(nlohmann::json jsonTask, const std::string& name, const std::string& iterations, bool synchronized,
 					const std::map<std::string, std::string>& arguments, int numNodes, int numGpusPerNode);
 
-	template<typename T>
+	[[nodiscard]] static PfsStriping
+	readPfsStriping(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments);
+
+	[[nodiscard]] static bool isCollective(const std::string& type);
+
+	[[nodiscard]] static bool isGpuCollective(const std::string& type);
+
+	[[nodiscard]] static std::string
+	readCollectiveModel(nlohmann::json jsonTask, const std::map<std::string, std::string>& arguments);
+
+	[[nodiscard]] static Collective readCollective(nlohmann::json jsonTask, const std::string& type, double bytes);
+
+	template<typename T, typename... Args>
 	[[nodiscard]] static std::unique_ptr<T>
 	createIoTask(nlohmann::json jsonTask, const std::string& name, const std::string& iterations, bool synchronized,
-				 const std::map<std::string, std::string>& arguments, int numNodes, int numGpusPerNode);
+				 const std::map<std::string, std::string>& arguments, int numNodes, int numGpusPerNode,
+				 Args&& ... extraArguments);
 
 	[[nodiscard]] static std::unique_ptr<Task>
 	createCombinedGpuTask(nlohmann::json jsonTask, const std::string& name, const std::string& iterations,
@@ -128,6 +153,13 @@ public:
 	createMatrices(const std::string& model, MatrixPattern pattern, int numNodes, int numGpusPerNode,
 				   const std::map<std::string, std::string>& runtimeArguments);
 
+	[[nodiscard]] static uint64_t hash(const std::string& string);
+
+	[[nodiscard]] static nlohmann::json compressNodeIds(const std::vector<Node*>& nodes);
+
+	[[nodiscard]] static std::vector<Node*>
+	expandNodeIds(const nlohmann::json& jsonNodeIds, const std::vector<Node*>& nodes);
+
 	[[nodiscard]] static std::vector<std::unique_ptr<Job>> readJobs(const std::string& jobsFile);
 
 	static double logTaskStart(const Task* task, int iterations);
@@ -0,0 +1,77 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include <cmath>
+#include <functional>
+
+#include "TestSupport.h"
+#include "Collective.h"
+
+static const double BYTES = 1 << 20;
+
+// compares the bytes every rank sends with the closed-form totals of Thakur, Rabenseifner and Gropp (2005)
+static void checkBytesPerRank(CollectiveOperation operation, CollectiveAlgorithm algorithm, int numRanks,
+							  const std::function<double(int rank)>& expected) {
+	std::vector<double> bytesPerRank = Collective(operation, algorithm, false, BYTES).getBytesPerRank(numRanks);
+	CHECK((int) bytesPerRank.size() == numRanks);
+	for (int rank = 0; rank < (int) bytesPerRank.size(); ++rank) {
+		if (std::abs(bytesPerRank[rank] - expected(rank)) > 1e-9 * BYTES) {
+			std::cerr << "operation " << operation << ", algorithm " << algorithm << ", " << numRanks
+					  << " ranks, rank " << rank << ": " << bytesPerRank[rank] << " bytes instead of "
+					  << expected(rank) << std::endl;
+			CHECK(false);
+		}
+	}
+}
+
+static void testNumRanks(int n) {
+	int powerOfTwo = 1 << (int) std::log2(n);
+	int levels = (int) std::log2(powerOfTwo);
+	int extra = n - powerOfTwo;
+	// non-power-of-two rank counts: the extra ranks fold their buffer into the first ranks and receive the result
+	const auto& folds = [&](int rank) { return (rank >= powerOfTwo ? BYTES : 0) + (rank < extra ? BYTES : 0); };
+
+	checkBytesPerRank(COLLECTIVE_ALLREDUCE, ALGORITHM_RING, n, [&](int) {
+		return 2.0 * (n - 1) / n * BYTES;
+	});
+	checkBytesPerRank(COLLECTIVE_ALLREDUCE, ALGORITHM_RECURSIVE_DOUBLING, n, [&](int rank) {
+		return (rank < powerOfTwo ? levels * BYTES : 0) + folds(rank);
+	});
+	checkBytesPerRank(COLLECTIVE_ALLREDUCE, ALGORITHM_RABENSEIFNER, n, [&](int rank) {
+		return (rank < powerOfTwo ? 2.0 * (powerOfTwo - 1) / powerOfTwo * BYTES : 0) + folds(rank);
+	});
+	checkBytesPerRank(COLLECTIVE_REDUCE_SCATTER, ALGORITHM_RING, n, [&](int) {
+		return (double) (n - 1) / n * BYTES;
+	});
+	checkBytesPerRank(COLLECTIVE_ALLGATHER, ALGORITHM_RING, n, [&](int) {
+		return (double) (n - 1) / n * BYTES;
+	});
+	checkBytesPerRank(COLLECTIVE_BCAST, ALGORITHM_RING, n, [&](int rank) {
+		return rank < n - 1 ? BYTES : 0;
+	});
+	checkBytesPerRank(COLLECTIVE_ALLTOALL, ALGORITHM_RING, n, [&](int) {
+		return (double) (n - 1) / n * BYTES;
+	});
+	// Bruck: block j is forwarded once for every set bit of j
+	checkBytesPerRank(COLLECTIVE_ALLTOALL, ALGORITHM_RECURSIVE_DOUBLING, n, [&](int) {
+		int blocks = 0;
+		for (int block = 1; block < n; ++block) {
+			blocks += __builtin_popcount(block);
+		}
+		return (double) blocks / n * BYTES;
+	});
+}
+
+int main() {
+	for (int numRanks: {2, 3, 8, 12}) {
+		testNumRanks(numRanks);
+	}
+	return TestSupport::result();
+}
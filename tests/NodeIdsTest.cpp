@@ -0,0 +1,63 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include <json.hpp>
+
+#include "TestSupport.h"
+#include "Utility.h"
+
+static const int NUM_NODES = 32;
+
+static void testCompress() {
+	CHECK(Utility::compressNodeIds({}) == nlohmann::json::array());
+	CHECK(Utility::compressNodeIds(TestSupport::selectNodes({4})) == nlohmann::json::parse("[4]"));
+	CHECK(Utility::compressNodeIds(TestSupport::selectNodes({0, 1, 2, 3})) == nlohmann::json::parse("[[0, 3]]"));
+	CHECK(Utility::compressNodeIds(TestSupport::selectNodes({0, 1, 3, 5, 6, 7, 9})) ==
+		  nlohmann::json::parse("[[0, 1], 3, [5, 7], 9]"));
+	// only ascending runs are merged, the order of nodes is preserved
+	CHECK(Utility::compressNodeIds(TestSupport::selectNodes({7, 8, 2, 3, 4, 1})) ==
+		  nlohmann::json::parse("[[7, 8], [2, 4], 1]"));
+	CHECK(Utility::compressNodeIds(TestSupport::selectNodes({3, 2, 1})) == nlohmann::json::parse("[3, 2, 1]"));
+}
+
+static void testExpand() {
+	const std::vector<Node*>& nodes = TestSupport::getNodes();
+	CHECK(Utility::expandNodeIds(nlohmann::json::array(), nodes).empty());
+	CHECK(Utility::expandNodeIds(nlohmann::json::parse("[5, 2]"), nodes) == TestSupport::selectNodes({5, 2}));
+	CHECK(Utility::expandNodeIds(nlohmann::json::parse("[[30, 31], 0, [4, 4]]"), nodes) ==
+		  TestSupport::selectNodes({30, 31, 0, 4}));
+	CHECK(Utility::expandNodeIds(nlohmann::json::parse("[[0, 31]]"), nodes) == nodes);
+}
+
+static void testRoundTrip() {
+	const std::vector<Node*>& nodes = TestSupport::getNodes();
+	std::vector<std::vector<int>> selections = {
+			{},
+			{0},
+			{31},
+			{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28,
+			 29, 30, 31},
+			{1, 3, 5, 7},
+			{10, 11, 12, 0, 1, 31, 30, 29, 20, 21}
+	};
+	for (const auto& selection: selections) {
+		std::vector<Node*> selectedNodes = TestSupport::selectNodes(selection);
+		CHECK(Utility::expandNodeIds(Utility::compressNodeIds(selectedNodes), nodes) == selectedNodes);
+	}
+}
+
+int main(int argc, char* argv[]) {
+	TestSupport::initPlatform(argc, argv, NUM_NODES);
+	testCompress();
+	testExpand();
+	testRoundTrip();
+	TestSupport::finalizePlatform();
+	return TestSupport::result();
+}
@@ -0,0 +1,84 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "TestSupport.h"
+#include "NodeSet.h"
+
+// spans several words to cover word boundaries and sets of different word counts
+static const int NUM_NODES = 200;
+
+static void testInsertEraseContains() {
+	const std::vector<Node*>& nodes = TestSupport::getNodes();
+	NodeSet set;
+	CHECK(set.empty());
+	CHECK(set.size() == 0);
+	CHECK(!set.contains(nodes[0]));
+	set.insert(nodes[0]);
+	set.insert(nodes[63]);
+	set.insert(nodes[64]);
+	set.insert(nodes[199]);
+	set.insert(nodes[64]);
+	CHECK(set.size() == 4);
+	CHECK(set.contains(nodes[0]) && set.contains(nodes[63]) && set.contains(nodes[64]) && set.contains(nodes[199]));
+	CHECK(!set.contains(nodes[1]) && !set.contains(nodes[65]) && !set.contains(nodes[128]));
+	set.erase(nodes[63]);
+	set.erase(nodes[100]);
+	CHECK(set.size() == 3);
+	CHECK(!set.contains(nodes[63]));
+	set.clear();
+	CHECK(set.empty());
+	CHECK(!set.contains(nodes[199]));
+	// erasing from or querying a set with fewer words than the node ID requires
+	NodeSet small(TestSupport::selectNodes({1}));
+	small.erase(nodes[199]);
+	CHECK(!small.contains(nodes[199]));
+	CHECK(small.size() == 1);
+}
+
+static void testSetAlgebra() {
+	NodeSet a(TestSupport::selectNodes({0, 5, 64, 130}));
+	NodeSet b(TestSupport::selectNodes({5, 64, 65}));
+	CHECK((a & b) == NodeSet(TestSupport::selectNodes({5, 64})));
+	CHECK((b & a) == NodeSet(TestSupport::selectNodes({5, 64})));
+	CHECK((a | b) == NodeSet(TestSupport::selectNodes({0, 5, 64, 65, 130})));
+	CHECK((b | a) == NodeSet(TestSupport::selectNodes({0, 5, 64, 65, 130})));
+	CHECK((a - b) == NodeSet(TestSupport::selectNodes({0, 130})));
+	CHECK((b - a) == NodeSet(TestSupport::selectNodes({65})));
+	CHECK((a - a).empty());
+	CHECK((a & NodeSet()).empty());
+	CHECK((a | NodeSet()) == a);
+	// equality ignores trailing empty words
+	NodeSet c(TestSupport::selectNodes({5, 199}));
+	c.erase(TestSupport::getNodes()[199]);
+	CHECK(c == NodeSet(TestSupport::selectNodes({5})));
+	CHECK(NodeSet(TestSupport::selectNodes({5})) == c);
+	CHECK(c != a);
+	CHECK(NodeSet() == NodeSet());
+}
+
+static void testResolveOrder() {
+	const std::vector<Node*>& nodes = TestSupport::getNodes();
+	// resolved nodes are ordered by ID, independent of the insertion order
+	NodeSet set(TestSupport::selectNodes({130, 3, 64, 0, 63}));
+	std::vector<Node*> resolved = set.resolve(nodes);
+	CHECK(resolved == TestSupport::selectNodes({0, 3, 63, 64, 130}));
+	CHECK(NodeSet().resolve(nodes).empty());
+	std::vector<Node*> all = NodeSet(nodes).resolve(nodes);
+	CHECK(all == nodes);
+}
+
+int main(int argc, char* argv[]) {
+	TestSupport::initPlatform(argc, argv, NUM_NODES);
+	testInsertEraseContains();
+	testSetAlgebra();
+	testResolveOrder();
+	TestSupport::finalizePlatform();
+	return TestSupport::result();
+}
@@ -0,0 +1,87 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#include "TestSupport.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <unistd.h>
+#include <simgrid/s4u.hpp>
+
+#include "SyntheticScenario.h"
+#include "Configuration.h"
+#include "PlatformManager.h"
+#include "Node.h"
+#include "NodeClass.h"
+
+namespace fs = std::filesystem;
+
+int TestSupport::failures = 0;
+
+static fs::path directory;
+static std::unique_ptr<simgrid::s4u::Engine> engine;
+static std::ofstream nodeUtilization;
+static std::ofstream taskTimes;
+
+void TestSupport::check(bool condition, const char* expression, const char* file, int line) {
+	if (!condition) {
+		std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+		++failures;
+	}
+}
+
+int TestSupport::result() {
+	if (failures > 0) {
+		std::cerr << failures << " check(s) failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+void TestSupport::initPlatform(int argc, char* argv[], int numNodes) {
+	directory = fs::temp_directory_path() / ("elastisim-test-" + std::to_string(getpid()));
+	Configuration::init(SyntheticScenario::writeConfiguration(directory, numNodes, "rigid", 1, 1));
+	int engineArgc = 2;
+	char* engineArgv[] = {argc > 0 ? argv[0] : (char*) "elastisim-test", (char*) "--log=root.thresh:critical",
+						  nullptr};
+	engine = std::make_unique<simgrid::s4u::Engine>(&engineArgc, engineArgv);
+	engine->load_platform(Configuration::get("platform_file"));
+
+	nodeUtilization.open("/dev/null");
+	std::vector<std::unique_ptr<NodeClass>> nodeClasses;
+	nodeClasses.push_back(std::make_unique<NodeClass>(0, "compute", COMPUTE_NODE,
+													  std::vector<s4u_Host*>{engine->host_by_name("pfs")}, 0, 0, 0, 0,
+													  0, 0));
+	std::vector<std::unique_ptr<Node>> nodes;
+	for (int i = 0; i < numNodes; ++i) {
+		nodes.push_back(std::make_unique<Node>(i, nodeClasses.front().get(),
+											   engine->host_by_name("node" + std::to_string(i)), nodeUtilization,
+											   taskTimes));
+	}
+	PlatformManager::init(std::move(nodeClasses), std::move(nodes));
+	PlatformManager::clearModifiedComputeNodes();
+}
+
+const std::vector<Node*>& TestSupport::getNodes() {
+	return PlatformManager::getComputeNodes();
+}
+
+std::vector<Node*> TestSupport::selectNodes(const std::vector<int>& ids) {
+	std::vector<Node*> selectedNodes;
+	for (int id: ids) {
+		selectedNodes.push_back(getNodes()[id]);
+	}
+	return selectedNodes;
+}
+
+void TestSupport::finalizePlatform() {
+	fs::remove_all(directory);
+}
@@ -0,0 +1,46 @@
+/*
+ * This file is part of the ElastiSim software.
+ *
+ * Copyright (c) 2022, Technical University of Darmstadt, Germany
+ *
+ * This software may be modified and distributed under the terms of the 3-Clause
+ * BSD License. See the LICENSE file in the base directory for details.
+ *
+ */
+
+#ifndef ELASTISIM_TESTSUPPORT_H
+#define ELASTISIM_TESTSUPPORT_H
+
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+class Node;
+
+// records a failed expectation and continues, the test executable exits with TestSupport::result()
+#define CHECK(condition) TestSupport::check((condition), #condition, __FILE__, __LINE__)
+
+// loads a synthetic platform with the given number of compute nodes for tests that need nodes, no actors are started
+class TestSupport {
+
+private:
+	static int failures;
+
+public:
+	static void check(bool condition, const char* expression, const char* file, int line);
+
+	[[nodiscard]] static int result();
+
+	static void initPlatform(int argc, char* argv[], int numNodes);
+
+	[[nodiscard]] static const std::vector<Node*>& getNodes();
+
+	[[nodiscard]] static std::vector<Node*> selectNodes(const std::vector<int>& ids);
+
+	static void finalizePlatform();
+
+};
+
+
+#endif //ELASTISIM_TESTSUPPORT_H